@@ -0,0 +1,1094 @@
+#include "pch.h"
+#include <chrono>
+#include <functional>
+#include "CharScanner.h"
+#include "InputFileReader.h"
+#include "LexicalAnalyzer.h"
+#include "Parallel.h"
+#include "FST.h"
+#include "Keywords.h"
+#include "Error.h"
+#include "Greibach.h"
+#include "SyntaxAnalyzer.h"
+#include "PredictiveTable.h"
+#include "SemanticAnalyzer.h"
+#include "PolishNotation.h"
+#include "CodeGeneration.h"
+#include "Snapshot.h"
+
+namespace
+{
+	//    ,      
+	std::atomic<size_t> allocationsCount{ 0 };
+}
+
+void* operator new(size_t size)
+{
+	allocationsCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace
+{
+	using namespace TTM;
+	using clock_type = std::chrono::steady_clock;
+
+	const char* benchmarkFilePath = "benchmark.ttm";
+	const char* keywordsFilePath = "keywords.ttm";
+	const char* stressFilePath = "stress.ttm";
+	const char* stressOutFilePath = "stress.asm";
+	const char* mfstRulesFilePath = "mfst.rules.txt";
+	const char* predictiveRulesFilePath = "ll1.rules.txt";
+	const char* snapshotFilePath = "benchmark.snap";
+	const char* traceFilePath = "benchmark.trace.txt";
+
+	//    ,   ,    
+	std::string makeSource(size_t size)
+	{
+		std::string text;
+		text.reserve(size + 128);
+
+		for (int i = 0; text.size() < size; ++i)
+		{
+			text += "let i32 generatedIdentifierNumber" + std::to_string(i) + " = anotherLongIdentifier" + std::to_string(i % 97) + " + 12345;\n";
+			if (i % 4 == 0)
+				text += "echo 'string literal body with some words in it " + std::to_string(i) + "';\n";
+			if (i % 8 == 0)
+				text += "// comment line that the reader has to skip entirely " + std::to_string(i) + "\n";
+		}
+
+		return text;
+	}
+
+	//         
+	std::string makeProgram(size_t size)
+	{
+		std::string text = "fn i32 sum(i32 p, i32 q)\n{\nlet i32 acc = p + q;\nret acc;\n}\nfn i32 main()\n{\nlet i32 z = 0;\nlet str m = 'bench';\n";
+		text.reserve(size + 128);
+
+		while (text.size() < size)
+		{
+			text += "z = z + sum(z, 12) * 3 - 7 % 5;\n";
+			text += "echo m;\n";
+		}
+		text += "ret 0;\n}\n";
+
+		return text;
+	}
+
+	//     FST,        DFA:    
+	class FstRunner
+	{
+	public:
+		explicit FstRunner(const FST::FST& fst)
+			: m_fst(fst), m_states(fst.nstates), m_scratch(fst.nstates)
+		{
+			//  Shift-And  : m_shiftMasks[c] -     c   ,
+			// m_loopMasks[c] -  ; ,    64    
+			if (fst.nstates > 64)
+				return;
+
+			std::vector<unsigned long long> shift(256), loop(256);
+			for (short i = 0; i < fst.nstates; ++i)
+			{
+				for (short j = 0; j < fst.nodes[i].n_relation; ++j)
+				{
+					const FST::RELATION& relation = fst.nodes[i].relations[j];
+					const unsigned char c = static_cast<unsigned char>(relation.symbol);
+					if (relation.nnode == i + 1)
+						shift[c] |= 1ULL << i;
+					else if (relation.nnode == i)
+						loop[c] |= 1ULL << i;
+					else
+						return;
+				}
+			}
+			m_shiftMasks.swap(shift);
+			m_loopMasks.swap(loop);
+		}
+
+		//     ,  -   
+		bool executeShiftAnd(std::string_view str)
+		{
+			if (m_shiftMasks.empty())
+				return executeRelations(str);
+
+			//  i ,    i;    0
+			unsigned long long active = 1;
+			for (char c : str)
+			{
+				const unsigned char symbol = static_cast<unsigned char>(c);
+				active = ((active & m_shiftMasks[symbol]) << 1) | (active & m_loopMasks[symbol]);
+				if (!active)
+					return false;
+			}
+
+			return (active >> (m_fst.nstates - 1)) & 1;
+		}
+
+		//     :  m_states  ,    ,  -1
+		bool executeRelations(std::string_view str)
+		{
+			std::fill(m_states.begin(), m_states.end(), -1);
+			m_states[0] = 0;
+			const int length = static_cast<int>(str.size());
+			for (int position = 0; position < length; ++position)
+			{
+				std::fill(m_scratch.begin(), m_scratch.end(), -1);
+				bool moved = false;
+				for (short i = 0; i < m_fst.nstates; ++i)
+				{
+					if (m_states[i] != position)
+						continue;
+					for (short j = 0; j < m_fst.nodes[i].n_relation; ++j)
+					{
+						if (m_fst.nodes[i].relations[j].symbol == str[position])
+						{
+							m_scratch[m_fst.nodes[i].relations[j].nnode] = position + 1;
+							moved = true;
+						}
+					}
+				}
+				if (!moved)
+					return false;
+				m_states.swap(m_scratch);
+			}
+
+			return m_states[m_fst.nstates - 1] == length;
+		}
+
+	private:
+		const FST::FST& m_fst;
+		std::vector<int> m_states;
+		std::vector<int> m_scratch;
+		std::vector<unsigned long long> m_shiftMasks;
+		std::vector<unsigned long long> m_loopMasks;
+	};
+
+	//  FST    ,    
+	struct FstSet
+	{
+		std::vector<std::unique_ptr<FST::FST>> fsts;
+		std::string lexemes;
+		std::vector<FstRunner> runners;
+
+		FstSet()
+		{
+			LexicalAnalyzer::tokenFsts(fsts, lexemes);
+			for (const auto& fst : fsts)
+				runners.emplace_back(*fst);
+		}
+	};
+
+	//      :   
+	std::string letters(int number)
+	{
+		std::string text;
+		do
+		{
+			text += static_cast<char>('a' + number % 26);
+			number /= 26;
+		} while (number > 0);
+		return text;
+	}
+
+	//       suite;    
+	std::string makeFunctionsProgram(size_t size)
+	{
+		std::string text;
+		std::string calls;
+		for (int i = 0; text.size() < size; ++i)
+		{
+			const std::string name = "function" + letters(i);
+			text += "fn i32 " + name + "(i32 first, i32 second, str label)\n{\nlet i32 local = first * second;\necho label;\nret local + " + std::to_string(i % 100) + ";\n}\n";
+			if (i % 16 == 0)
+				calls += "z = z + " + name + "(z, 2, 'call');\n";
+		}
+		return text + "fn i32 main()\n{\nlet i32 z = 0;\n" + calls + "ret z;\n}\n";
+	}
+
+	std::string makeExpressionsProgram(size_t size)
+	{
+		std::string text = "fn i32 main()\n{\nlet i32 a = 1;\nlet i32 b = 2;\nlet i32 z = 0;\n";
+		while (text.size() < size)
+		{
+			text += "z = a";
+			for (int i = 0; i < 64; ++i)
+				text += (i % 4 == 0) ? " + (b * " + std::to_string(i) + " - a)" : (i % 4 == 1) ? " * b" : (i % 4 == 2) ? " - 17 % a" : " / (z + 3)";
+			text += ";\n";
+		}
+		return text + "ret z;\n}\n";
+	}
+
+	std::string makeLiteralsProgram(size_t size)
+	{
+		std::string text = "fn i32 main()\n{\nlet str s = 'start';\nlet i32 n = 0;\n";
+		for (int i = 0; text.size() < size; ++i)
+		{
+			//     1000:   ,   
+			text += "echo 'string literal number " + std::to_string(i % 1000) + " with some text';\n";
+			text += "n = " + std::to_string(100000 + i % 1000) + ";\n";
+			text += "s = concat(s, 'tail');\n";
+		}
+		return text + "ret 0;\n}\n";
+	}
+
+	//   :     
+	std::string makeVectorsProgram(size_t size)
+	{
+		std::string text = "fn i32 main()\n{\nlet i32 n = 0;\n";
+		for (int i = 0; text.size() < size; ++i)
+		{
+			text += "n = " + std::to_string(1000000 + i) + ";\n";
+			text += "echo 'vector " + std::to_string(i) + "';\n";
+		}
+		return text + "ret 0;\n}\n";
+	}
+
+	std::string makeNestingProgram(size_t size)
+	{
+		const int depth = 32;
+		std::string text = "fn i32 main()\n{\nlet i32 z = 1;\n";
+		while (text.size() < size)
+		{
+			for (int i = 0; i < depth; ++i)
+				text += std::string(i, ' ') + "if z {\n";
+			text += std::string(depth, ' ') + "z = z + 1;\n";
+			for (int i = depth - 1; i >= 0; --i)
+				text += std::string(i, ' ') + (i % 2 ? "}\n" : "}\n" + std::string(i, ' ') + "else {\n" + std::string(i, ' ') + "echo z;\n" + std::string(i, ' ') + "}\n");
+		}
+		return text + "ret z;\n}\n";
+	}
+
+	// ,    :       
+	char tokenizeFst(std::string_view str, FstSet& set, bool (FstRunner::*execute)(std::string_view) = &FstRunner::executeShiftAnd)
+	{
+		for (size_t i = 0; i < set.runners.size(); ++i)
+		{
+			if ((set.runners[i].*execute)(str))
+				return set.lexemes[i];
+		}
+		return EOF;
+	}
+
+	template<class Function>
+	double measure(int repeats, Function function)
+	{
+		double best = 0;
+		for (int i = 0; i < repeats; ++i)
+		{
+			auto start = clock_type::now();
+			function();
+			double seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+			if (i == 0 || seconds < best)
+				best = seconds;
+		}
+		return best;
+	}
+
+	size_t allocationsDuring(const std::function<void()>& function)
+	{
+		const size_t before = allocationsCount.load();
+		function();
+		return allocationsCount.load() - before;
+	}
+
+	void report(const char* name, const char* level, size_t bytes, double seconds, size_t checksum)
+	{
+		std::cout << name << ',' << level << ',' << bytes << ',' << std::fixed << std::setprecision(6) << seconds << ','
+			<< std::setprecision(1) << bytes / seconds / (1024 * 1024) << ',' << checksum << '\n';
+	}
+
+	//    switch  m_codeTable,   InputFileReader::read  
+	size_t scanScalarSwitch(const std::string& text, const int* codeTable)
+	{
+		size_t tokens = 0;
+		bool inIdentifier = false;
+
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			unsigned char c = static_cast<unsigned char>(text[i]);
+			if (c == in::comment && i + 1 < text.size() && text[i + 1] == in::comment)
+			{
+				while (i < text.size() && text[i] != in::endl)
+					++i;
+				inIdentifier = false;
+				continue;
+			}
+
+			switch (codeTable[c])
+			{
+			case in::T:
+				if (!inIdentifier)
+					++tokens;
+				inIdentifier = true;
+				continue;
+
+			case in::Q:
+				++i;
+				while (i < text.size() && codeTable[static_cast<unsigned char>(text[i])] != in::Q)
+					++i;
+				++tokens;
+				break;
+
+			case in::O:
+			case in::S:
+				++tokens;
+				break;
+
+			default:
+				break;
+			}
+			inIdentifier = false;
+		}
+
+		return tokens;
+	}
+
+	//   ,  ,      
+	size_t scanVectorized(const std::string& text, const int* codeTable, const scan::Scanner& scanner)
+	{
+		size_t tokens = 0;
+		const char* position = text.data();
+		const char* const end = position + text.size();
+
+		while (position != end)
+		{
+			unsigned char c = static_cast<unsigned char>(*position);
+			if (c == in::comment && position + 1 != end && position[1] == in::comment)
+			{
+				position = scanner.findNewline(position, end);
+				continue;
+			}
+
+			switch (codeTable[c])
+			{
+			case in::T:
+				position = scanner.findNonIdentifier(position, end);
+				++tokens;
+				continue;
+
+			case in::Q:
+				position = scanner.findQuote(position + 1, end);
+				if (position == end)
+					continue;
+				++tokens;
+				break;
+
+			case in::O:
+			case in::S:
+				++tokens;
+				break;
+
+			default:
+				break;
+			}
+			++position;
+		}
+
+		return tokens;
+	}
+
+	// bench suite [bytes] [functions|expressions|literals|vectors|nesting|all]:    ,
+	//               
+	int runSuite(int argc, char** argv)
+	{
+		const size_t size = (argc > 0) ? static_cast<size_t>(atoll(argv[0])) : 256 * 1024;
+		const std::string shape = (argc > 1) ? argv[1] : "all";
+		const int repeats = 5;
+
+		struct Shape
+		{
+			const char* name;
+			std::string(*make)(size_t);
+		};
+		const Shape shapes[] = {
+			{ "functions", makeFunctionsProgram },
+			{ "expressions", makeExpressionsProgram },
+			{ "literals", makeLiteralsProgram },
+			{ "vectors", makeVectorsProgram },
+			{ "nesting", makeNestingProgram }
+		};
+
+		std::cout << "shape,stage,bytes,tokens,seconds,tokens/s,bytes/s,allocations,allocations/token\n";
+		auto row = [](const char* shape, const char* stage, size_t bytes, size_t tokens, double seconds, size_t allocations)
+		{
+			std::cout << shape << ',' << stage << ',' << bytes << ',' << tokens << ',' << std::fixed << std::setprecision(6) << seconds << ','
+				<< std::setprecision(0) << tokens / seconds << ',' << bytes / seconds << ',' << allocations << ','
+				<< std::setprecision(4) << static_cast<double>(allocations) / std::max<size_t>(tokens, 1) << '\n';
+		};
+
+		try
+		{
+			for (const Shape& s : shapes)
+			{
+				if (shape != "all" && shape != s.name)
+					continue;
+
+				const std::string source = s.make(size);
+				std::ofstream(benchmarkFilePath, std::ios::binary) << source;
+
+				InputFileReader in;
+				size_t allocations = allocationsDuring([&]() { in.read(benchmarkFilePath); });
+				double seconds = measure(repeats, [&]() { InputFileReader reader; reader.read(benchmarkFilePath); });
+				const size_t tokens = in.tokens().size();
+				row(s.name, "read", source.size(), tokens, seconds, allocations);
+
+				//  splitStringByDelimiter:       
+				allocations = allocationsDuring([&]() { InputFileReader reader; reader.readText(source); });
+				seconds = measure(repeats, [&]() { InputFileReader reader; reader.readText(source); });
+				row(s.name, "readText", source.size(), tokens, seconds, allocations);
+
+				auto scan = [&]()
+				{
+					LexTable lextable{ tokens };
+					IdTable idtable{};
+					LexicalAnalyzer lexicalAnalyzer{ lextable, idtable };
+					Logger log{ };
+					lexicalAnalyzer.Scan(in.source(), in.tokens(), log);
+				};
+				allocations = allocationsDuring(scan);
+				seconds = measure(repeats, scan);
+				row(s.name, "scan", source.size(), tokens, seconds, allocations);
+			}
+		}
+		catch (Error::ERROR e)
+		{
+			std::cerr << "error " << e.id << ' ' << e.message << '\n';
+			std::remove(benchmarkFilePath);
+			return 1;
+		}
+		std::remove(benchmarkFilePath);
+
+		return 0;
+	}
+
+	std::string readFile(const char* filePath)
+	{
+		std::ifstream file(filePath, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	// bench syntax [bytes] [shape|all]:      LL(1)    suite;
+	//      
+	int runSyntax(int argc, char** argv)
+	{
+		const size_t size = (argc > 0) ? static_cast<size_t>(atoll(argv[0])) : 64 * 1024;
+		const std::string shape = (argc > 1) ? argv[1] : "all";
+
+		//  32  if/else     (   16 -    ),
+		//  nesting   
+		struct Shape
+		{
+			const char* name;
+			std::string(*make)(size_t);
+			bool mfst;
+		};
+		const Shape shapes[] = {
+			{ "functions", makeFunctionsProgram, true },
+			{ "expressions", makeExpressionsProgram, true },
+			{ "literals", makeLiteralsProgram, true },
+			{ "vectors", makeVectorsProgram, true },
+			{ "nesting", makeNestingProgram, false }
+		};
+
+		const GRB::Greibach greibach = GRB::getGreibach();
+		const GRB::PredictiveTable table{ greibach };
+		std::cout << "LL(1) conflicts: " << table.conflicts().size() << '\n';
+		std::cout << "shape,parser,tokens,seconds,tokens/s\n";
+		auto row = [](const char* shape, const char* parser, size_t tokens, double seconds)
+		{
+			std::cout << shape << ',' << parser << ',' << tokens << ',' << std::fixed << std::setprecision(6) << seconds << ','
+				<< std::setprecision(0) << tokens / seconds << '\n';
+		};
+
+		int output = 0;
+		try
+		{
+			for (const Shape& s : shapes)
+			{
+				if (shape != "all" && shape != s.name)
+					continue;
+
+				std::ofstream(benchmarkFilePath, std::ios::binary) << s.make(size);
+				InputFileReader in;
+				in.read(benchmarkFilePath);
+
+				Logger log{ };
+				LexTable lextable{ in.tokens().size() };
+				IdTable idtable{};
+				LexicalAnalyzer lexicalAnalyzer{ lextable, idtable };
+				lexicalAnalyzer.Scan(in.source(), in.tokens(), log);
+
+				SyntaxAnalyzer predictive{ lextable, greibach };
+				row(s.name, "ll1", lextable.size(), measure(1, [&]() { predictive.Start(log, table); }));
+				if (!s.mfst)
+					continue;
+
+				SyntaxAnalyzer mfst{ lextable, greibach };
+				row(s.name, "mfst", lextable.size(), measure(1, [&]() { mfst.Start(log); }));
+
+				{
+					BufferedWriter mfstRules(mfstRulesFilePath);
+					mfst.dumpRules(mfstRules);
+					BufferedWriter predictiveRules(predictiveRulesFilePath);
+					predictive.dumpRules(predictiveRules);
+				}
+				if (readFile(mfstRulesFilePath) != readFile(predictiveRulesFilePath))
+				{
+					std::cerr << s.name << ": LL(1) derivation differs from MFST\n";
+					output = 1;
+				}
+			}
+		}
+		catch (Error::ERROR e)
+		{
+			std::cerr << "error " << e.id << ' ' << e.message << '\n';
+			output = 1;
+		}
+		std::remove(benchmarkFilePath);
+		std::remove(mfstRulesFilePath);
+		std::remove(predictiveRulesFilePath);
+
+		return output;
+	}
+
+	// count   :  S     ,    
+	//      
+	std::string makeManyFunctionsProgram(int count)
+	{
+		std::string text;
+		for (int i = 0; i < count; ++i)
+			text += "fn i32 function" + letters(i) + "(i32 first, i32 second)\n{\nlet i32 local = first * second;\nret local + " + std::to_string(i % 100) + ";\n}\n";
+		return text + "fn i32 main()\n{\nlet i32 z = 0;\nz = functiona(z, 2);\nret z;\n}\n";
+	}
+
+	// bench functions [count]:      count/8, count/4, count/2  count  (  10k);
+	//       ,      
+	int runFunctions(int argc, char** argv)
+	{
+		const int count = (argc > 0) ? atoi(argv[0]) : 10000;
+
+		std::cout << "functions,tokens,seconds,tokens/s,allocations\n";
+		int output = 0;
+		try
+		{
+			const GRB::Greibach greibach = GRB::getGreibach();
+			for (int functions = std::max(count / 8, 1); functions <= count; functions *= 2)
+			{
+				std::ofstream(benchmarkFilePath, std::ios::binary) << makeManyFunctionsProgram(functions);
+				InputFileReader in;
+				in.read(benchmarkFilePath);
+
+				Logger log{ };
+				LexTable lextable{ in.tokens().size() };
+				IdTable idtable{};
+				LexicalAnalyzer lexicalAnalyzer{ lextable, idtable };
+				lexicalAnalyzer.Scan(in.source(), in.tokens(), log);
+
+				SyntaxAnalyzer syntaxAnalyzer{ lextable, greibach };
+				bool accepted = false;
+				size_t allocations = 0;
+				const double seconds = measure(1, [&]() { allocations = allocationsDuring([&]() { accepted = syntaxAnalyzer.Start(log); }); });
+				std::cout << functions << ',' << lextable.size() << ',' << std::fixed << std::setprecision(6) << seconds << ','
+					<< std::setprecision(0) << lextable.size() / seconds << ',' << allocations << '\n';
+				if (!accepted)
+				{
+					std::cerr << "functions: program with " << functions << " functions was not accepted\n";
+					output = 1;
+				}
+			}
+		}
+		catch (Error::ERROR e)
+		{
+			std::cerr << "error " << e.id << ' ' << e.message << '\n';
+			output = 1;
+		}
+		std::remove(benchmarkFilePath);
+
+		return output;
+	}
+
+	// bench trace [count]:    count  (  10k)      
+	//     ,  
+	int runTrace(int argc, char** argv)
+	{
+		const int count = (argc > 0) ? atoi(argv[0]) : 10000;
+
+		struct Program
+		{
+			const char* name;
+			std::string text;
+		};
+		const std::string functions = makeManyFunctionsProgram(count);
+		const Program programs[] = {
+			{ "functions", functions },
+			{ "expressions", makeExpressionsProgram(functions.size()) }
+		};
+
+		std::cout << "program,parser,trace,tokens,seconds,tokens/s,allocations\n";
+		auto row = [](const char* program, const char* parser, bool tracing, size_t tokens, double seconds, size_t allocations)
+		{
+			std::cout << program << ',' << parser << ',' << (tracing ? "on" : "off") << ',' << tokens << ',' << std::fixed << std::setprecision(6) << seconds << ','
+				<< std::setprecision(0) << tokens / seconds << ',' << allocations << '\n';
+		};
+
+		int output = 0;
+		try
+		{
+			const GRB::Greibach greibach = GRB::getGreibach();
+			const GRB::PredictiveTable table{ greibach };
+			for (const Program& program : programs)
+			{
+				std::ofstream(benchmarkFilePath, std::ios::binary) << program.text;
+				InputFileReader in;
+				in.read(benchmarkFilePath);
+
+				Logger log{ };
+				LexTable lextable{ in.tokens().size() };
+				IdTable idtable{};
+				LexicalAnalyzer lexicalAnalyzer{ lextable, idtable };
+				lexicalAnalyzer.Scan(in.source(), in.tokens(), log);
+
+				for (bool tracing : { false, true })
+				{
+					//       ,    
+					std::unique_ptr<BufferedWriter> trace;
+					size_t allocations = 0;
+					if (tracing)
+						trace = std::make_unique<BufferedWriter>(traceFilePath);
+					SyntaxAnalyzer mfst{ lextable, greibach, trace.get() };
+					double seconds = measure(1, [&]() { allocations = allocationsDuring([&]() { mfst.Start(log); if (trace) trace->flush(); }); });
+					row(program.name, "mfst", tracing, lextable.size(), seconds, allocations);
+
+					if (tracing)
+						trace = std::make_unique<BufferedWriter>(traceFilePath);
+					SyntaxAnalyzer predictive{ lextable, greibach, trace.get() };
+					seconds = measure(1, [&]() { allocations = allocationsDuring([&]() { predictive.Start(log, table); if (trace) trace->flush(); }); });
+					row(program.name, "ll1", tracing, lextable.size(), seconds, allocations);
+				}
+			}
+		}
+		catch (Error::ERROR e)
+		{
+			std::cerr << "error " << e.id << ' ' << e.message << '\n';
+			output = 1;
+		}
+		std::remove(benchmarkFilePath);
+		std::remove(traceFilePath);
+
+		return output;
+	}
+
+	//    tokens :   main     wideArguments ,
+	//    ,        short    
+	const int wideArguments = 300;
+
+	std::string makeStressProgram(size_t tokens)
+	{
+		std::string parameters;
+		std::string body;
+		std::string arguments;
+		for (int i = 0; i < wideArguments; ++i)
+		{
+			parameters += (i ? ", i32 p" : "i32 p") + letters(i);
+			body += (i ? " + p" : "p") + letters(i);
+			arguments += (i ? ", " : "") + std::to_string(i);
+		}
+
+		std::string text = "fn i32 wide(" + parameters + ")\n{\nlet i32 acc = " + body + ";\nret acc;\n}\n"
+			"fn i32 main()\n{\nlet i32 z = 0;\n";
+		const std::string line = "z = z + 12 * 3 - 7 % 5;\n";
+		const std::string call = "z = wide(" + arguments + ");\n";
+		const size_t lineTokens = 12;
+		const size_t callTokens = 2 * wideArguments + 4;
+
+		size_t count = 4 * wideArguments + 30;
+		for (int i = 0; count < tokens; ++i)
+		{
+			text += (i % 1000 == 0) ? call : line;
+			count += (i % 1000 == 0) ? callTokens : lineTokens;
+		}
+		return text + "echo z;\nret 0;\n}\n";
+	}
+
+	// bench stress [tokens]:       tokens  (  10M)
+	int runStress(int argc, char** argv)
+	{
+		const size_t tokens = (argc > 0) ? static_cast<size_t>(atoll(argv[0])) : 10 * 1000 * 1000;
+
+		std::ofstream(stressFilePath, std::ios::binary) << makeStressProgram(tokens);
+
+		std::cout << "stage,tokens,seconds,tokens/s\n";
+		size_t count = 0;
+		auto row = [&count](const char* stage, double seconds)
+		{
+			std::cout << stage << ',' << count << ',' << std::fixed << std::setprecision(3) << seconds << ','
+				<< std::setprecision(0) << count / seconds << '\n';
+		};
+
+		int output = 0;
+		try
+		{
+			Logger log{ };
+			InputFileReader in;
+			double seconds = measure(1, [&]() { in.read(stressFilePath); });
+			count = in.tokens().size();
+			row("read", seconds);
+
+			LexTable lextable{ in.tokens().size() };
+			IdTable idtable{};
+			LexicalAnalyzer lexicalAnalyzer{ lextable, idtable };
+			row("scan", measure(1, [&]() { lexicalAnalyzer.Scan(in.source(), in.tokens(), log); }));
+
+			SyntaxAnalyzer syntaxAnalyzer{ lextable, GRB::getGreibach() };
+			row("syntax", measure(1, [&]() { syntaxAnalyzer.Start(log); }));
+
+			SemanticAnalyzer semanticAnalyzer{ lextable, idtable };
+			row("semantic", measure(1, [&]() { semanticAnalyzer.Start(log); }));
+
+			row("polish", measure(1, [&]() { PolishNotation(lextable, idtable); }));
+
+			Generator codeGenerator{ lextable, idtable, stressOutFilePath };
+			row("generate", measure(1, [&]() { codeGenerator.Start(log); }));
+
+			//   wide     
+			for (int i = 0; i < lextable.size(); ++i)
+			{
+				if (lextable.lexeme(i) == LEX_ARGUMENTS_COUNT && lextable.idTableIndex(i) != wideArguments)
+				{
+					std::cerr << "stress: lexeme " << i << " has " << lextable.idTableIndex(i) << " arguments\n";
+					output = 1;
+				}
+			}
+		}
+		catch (Error::ERROR e)
+		{
+			std::cerr << "error " << e.id << ' ' << e.message << " line " << e.inext.line << '\n';
+			output = 1;
+		}
+		std::remove(stressFilePath);
+		std::remove(stressOutFilePath);
+
+		return output;
+	}
+
+	// bench snapshot [bytes]:  ,    ;     115,
+	//     
+	int runSnapshot(int argc, char** argv)
+	{
+		const size_t size = (argc > 0) ? static_cast<size_t>(atoll(argv[0])) : 64 * 1024;
+
+		std::string image;
+		try
+		{
+			//   :   ,       
+			std::string text = "fn i32 main()\n{\nlet i32 z = 0;\n";
+			while (text.size() < size)
+				text += "z = z + 12 * 3 - 7 % 5;\n";
+			std::ofstream(benchmarkFilePath, std::ios::binary) << text << "ret z;\n}\n";
+			InputFileReader in;
+			in.read(benchmarkFilePath);
+			Logger log{ };
+			LexTable lextable{ in.tokens().size() };
+			IdTable idtable{};
+			LexicalAnalyzer lexicalAnalyzer{ lextable, idtable };
+			lexicalAnalyzer.Scan(in.source(), in.tokens(), log);
+			snapshot::write(snapshotFilePath, snapshot::phase::lexical, lextable, idtable);
+
+			std::ifstream file(snapshotFilePath, std::ios::binary);
+			image.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+		catch (Error::ERROR e)
+		{
+			std::cerr << "error " << e.id << ' ' << e.message << '\n';
+			std::remove(benchmarkFilePath);
+			return 1;
+		}
+
+		// : magic, version, phase, entrySize (unsigned),  lexemesCount, entriesCount, stringsSize...
+		const size_t entriesCountOffset = 4 * sizeof(unsigned) + sizeof(unsigned long long);
+		const size_t stringsSizeOffset = entriesCountOffset + sizeof(unsigned long long);
+		auto withCount = [&image](size_t offset, unsigned long long count)
+		{
+			std::string corrupted = image;
+			std::memcpy(&corrupted[offset], &count, sizeof(count));
+			return corrupted;
+		};
+
+		struct Case
+		{
+			const char* name;
+			std::string image;
+			int expectedError;
+		};
+		const Case cases[] = {
+			{ "intact", image, 0 },
+			{ "truncated", image.substr(0, image.size() / 2), 115 },
+			{ "header-only", image.substr(0, 4 * sizeof(unsigned) + 5 * sizeof(unsigned long long)), 115 },
+			{ "strings-size", withCount(stringsSizeOffset, ~0ULL - 6), 115 },
+			{ "entries-count", withCount(entriesCountOffset, ~0ULL / sizeof(IdTable::Entry) + 2), 115 }
+		};
+
+		std::cout << "case,bytes,error,result\n";
+		int output = 0;
+		for (const Case& c : cases)
+		{
+			std::ofstream(snapshotFilePath, std::ios::binary) << c.image;
+			int error = 0;
+			try
+			{
+				LexTable lextable{};
+				IdTable idtable{};
+				snapshot::read(snapshotFilePath, lextable, idtable);
+			}
+			catch (Error::ERROR e)
+			{
+				error = e.id;
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << c.name << ": " << e.what() << '\n';
+				error = -1;
+			}
+
+			std::cout << c.name << ',' << c.image.size() << ',' << error << ',' << (error == c.expectedError ? "ok" : "FAILED") << '\n';
+			if (error != c.expectedError)
+				output = 1;
+		}
+		std::remove(benchmarkFilePath);
+		std::remove(snapshotFilePath);
+
+		return output;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && std::string_view(argv[1]) == "suite")
+		return runSuite(argc - 2, argv + 2);
+	if (argc > 1 && std::string_view(argv[1]) == "stress")
+		return runStress(argc - 2, argv + 2);
+	if (argc > 1 && std::string_view(argv[1]) == "syntax")
+		return runSyntax(argc - 2, argv + 2);
+	if (argc > 1 && std::string_view(argv[1]) == "functions")
+		return runFunctions(argc - 2, argv + 2);
+	if (argc > 1 && std::string_view(argv[1]) == "trace")
+		return runTrace(argc - 2, argv + 2);
+	if (argc > 1 && std::string_view(argv[1]) == "snapshot")
+		return runSnapshot(argc - 2, argv + 2);
+
+	size_t size = (argc > 1) ? static_cast<size_t>(atoll(argv[1])) : 32 * 1024 * 1024;
+	const int repeats = 5;
+	const scan::level levels[] = { scan::level::scalar, scan::level::sse2, scan::level::avx2 };
+
+	std::string source = makeSource(size);
+	const int codeTable[256] = { IN_CODE_TABLE };
+
+	std::cout << "benchmark,level,bytes,seconds,MB/s,checksum\n";
+
+	size_t tokens = 0;
+	double seconds = measure(repeats, [&]() { tokens = scanScalarSwitch(source, codeTable); });
+	report("classify", "switch", source.size(), seconds, tokens);
+
+	for (scan::level level : levels)
+	{
+		if (static_cast<int>(level) > static_cast<int>(scan::bestLevel()))
+			continue;
+
+		const scan::Scanner& scanner = scan::getScanner(level);
+		seconds = measure(repeats, [&]() { tokens = scanVectorized(source, codeTable, scanner); });
+		report("classify", scan::levelName(level), source.size(), seconds, tokens);
+	}
+
+	//  UTF-8:      (""  UTF-8)    
+	std::string utf8Source = source;
+	for (size_t i = 0; (i = utf8Source.find("'string", i)) != std::string::npos; i += 13)
+		utf8Source.replace(i + 1, 6, "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82");
+
+	for (scan::level level : levels)
+	{
+		if (static_cast<int>(level) > static_cast<int>(scan::bestLevel()))
+			continue;
+
+		const scan::Scanner& scanner = scan::getScanner(level);
+		bool valid = false;
+		seconds = measure(repeats, [&]() { valid = scanner.validateUtf8(utf8Source.data(), utf8Source.data() + utf8Source.size()); });
+		report("utf8", scan::levelName(level), utf8Source.size(), seconds, valid);
+	}
+
+	std::ofstream(benchmarkFilePath, std::ios::binary) << source;
+	try
+	{
+		for (scan::level level : levels)
+		{
+			if (static_cast<int>(level) > static_cast<int>(scan::bestLevel()))
+				continue;
+
+			scan::setLevel(level);
+			seconds = measure(repeats, [&]() {
+				InputFileReader in;
+				in.read(benchmarkFilePath);
+				tokens = in.tokens().size();
+			});
+			report("read", scan::levelName(level), source.size(), seconds, tokens);
+		}
+	}
+	catch (Error::ERROR e)
+	{
+		std::cerr << "error " << e.id << ' ' << e.message << '\n';
+	}
+
+	//     :        ;
+	//    FST    ,     
+	std::ofstream(benchmarkFilePath, std::ios::binary) << makeProgram(size / 64);
+	try
+	{
+		const size_t workers[] = { 1, 0 };
+		for (size_t maxWorkers : workers)
+		{
+			parallel::setMaxWorkers(maxWorkers);
+			const std::string name = maxWorkers == 1 ? "1" : std::to_string(parallel::workersCount(SIZE_MAX, 1));
+
+			InputFileReader in;
+			seconds = measure(1, [&]() { in.read(benchmarkFilePath); });
+			report("read-threads", name.c_str(), in.source().size(), seconds, in.tokens().size());
+
+			seconds = measure(1, [&]() {
+				LexTable lextable{ in.tokens().size() };
+				IdTable idtable{};
+				LexicalAnalyzer lexicalAnalyzer{ lextable, idtable };
+				Logger log{ };
+				lexicalAnalyzer.Scan(in.source(), in.tokens(), log);
+				tokens = lextable.size();
+			});
+			report("lex-threads", name.c_str(), in.source().size(), seconds, tokens);
+		}
+		parallel::setMaxWorkers(0);
+
+		//   :  FST,       ,   
+		{
+			InputFileReader in;
+			in.read(benchmarkFilePath);
+			const FST::DFA& automaton = LexicalAnalyzer::tokenAutomaton();
+
+			size_t checksum = 0;
+			seconds = measure(1, [&]() {
+				checksum = 0;
+				for (const in::TokenSpan& token : in.tokens())
+				{
+					FstSet set;
+					checksum += tokenizeFst(in.source().substr(token.offset, token.length), set);
+				}
+			});
+			report("tokenize", "fst", in.source().size(), seconds, checksum);
+
+			FstSet set;
+			seconds = measure(repeats, [&]() {
+				checksum = 0;
+				for (const in::TokenSpan& token : in.tokens())
+					checksum += tokenizeFst(in.source().substr(token.offset, token.length), set);
+			});
+			report("tokenize", "fst-reused", in.source().size(), seconds, checksum);
+
+			seconds = measure(repeats, [&]() {
+				checksum = 0;
+				for (const in::TokenSpan& token : in.tokens())
+					checksum += tokenizeFst(in.source().substr(token.offset, token.length), set, &FstRunner::executeRelations);
+			});
+			report("tokenize", "fst-relations", in.source().size(), seconds, checksum);
+
+			seconds = measure(repeats, [&]() {
+				checksum = 0;
+				for (const in::TokenSpan& token : in.tokens())
+					checksum += automaton.execute(in.source().substr(token.offset, token.length));
+			});
+			report("tokenize", "dfa", in.source().size(), seconds, checksum);
+		}
+
+		//        :  FST,        
+		{
+			std::string keywordSource;
+			while (keywordSource.size() < size / 4)
+				keywordSource += "fn i32 main ( ) { let str s = 'a' ; if ( x ) { ret 1 ; } else { echo s , x + y - z * 2 / 3 % 4 ; } }\n";
+			std::ofstream(keywordsFilePath, std::ios::binary) << keywordSource;
+
+			InputFileReader in;
+			in.read(keywordsFilePath);
+			const FST::DFA& automaton = LexicalAnalyzer::tokenAutomaton();
+
+			size_t checksum = 0;
+			FstSet set;
+			seconds = measure(1, [&]() {
+				checksum = 0;
+				for (const in::TokenSpan& token : in.tokens())
+					checksum += tokenizeFst(in.source().substr(token.offset, token.length), set);
+			});
+			report("keywords", "fst-reused", in.source().size(), seconds, checksum);
+
+			seconds = measure(repeats, [&]() {
+				checksum = 0;
+				for (const in::TokenSpan& token : in.tokens())
+					checksum += automaton.execute(in.source().substr(token.offset, token.length));
+			});
+			report("keywords", "dfa", in.source().size(), seconds, checksum);
+
+			seconds = measure(repeats, [&]() {
+				checksum = 0;
+				for (const in::TokenSpan& token : in.tokens())
+				{
+					const std::string_view str = in.source().substr(token.offset, token.length);
+					const char lexeme = keywords::find(str);
+					checksum += lexeme ? lexeme : automaton.execute(str);
+				}
+			});
+			report("keywords", "hash", in.source().size(), seconds, checksum);
+		}
+
+		//      :       
+		InputFileReader in;
+		in.read(benchmarkFilePath);
+		LexTable lextable{ in.tokens().size() };
+		IdTable idtable{};
+		LexicalAnalyzer lexicalAnalyzer{ lextable, idtable };
+		Logger log{ };
+		seconds = measure(1, [&]() { lexicalAnalyzer.Scan(in.source(), in.tokens(), log); });
+		report("relex", "full", in.source().size(), seconds, lextable.size());
+
+		const int editedLine = 10 + (in.linesCount() / 4) * 2;
+		const std::string editedText = "z = z + sum(z, 12) * 3 - 5 % 7;\n";
+		bool rescanned = false;
+		seconds = measure(repeats, [&]() { rescanned = lexicalAnalyzer.Rescan(editedText, editedLine, editedLine, log); });
+		report("relex", "line", editedText.size(), seconds, rescanned);
+
+		//   ,    :        ,
+		//    ;     ,    
+		const std::string literalText = "z = z + sum(z, 12) * 3 - 987654 % 7;\n";
+		const int idTableSize = idtable.size();
+		seconds = measure(repeats, [&]() { rescanned = lexicalAnalyzer.Rescan(literalText, editedLine, editedLine, log); });
+		report("relex", "literal", literalText.size(), seconds, rescanned && idtable.size() == idTableSize + 1);
+
+		//   CSV:         Scan,   Rescan
+		std::cerr << "tokenize calls per token: " << lexicalAnalyzer.tokenizeCallsPerToken() << '\n';
+	}
+	catch (Error::ERROR e)
+	{
+		std::cerr << "error " << e.id << ' ' << e.message << '\n';
+	}
+	std::remove(benchmarkFilePath);
+	std::remove(keywordsFilePath);
+
+	return 0;
+}
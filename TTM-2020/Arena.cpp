@@ -0,0 +1,61 @@
+#include "pch.h"
+#include "Arena.h"
+
+namespace
+{
+	//   ;   
+	constexpr size_t initialBlockSize = 64 * 1024;
+}
+
+TTM::Arena::Arena()
+	: m_buffer(initialBlockSize, &m_upstream)
+{
+	m_previous = std::pmr::set_default_resource(this);
+}
+
+TTM::Arena::~Arena()
+{
+	std::pmr::set_default_resource(m_previous);
+	m_buffer.release();
+}
+
+size_t TTM::Arena::phaseUsed()
+{
+	const size_t phase = m_used - m_mark;
+	m_mark = m_used;
+	return phase;
+}
+
+void* TTM::Arena::do_allocate(size_t bytes, size_t alignment)
+{
+	m_used += bytes;
+	return m_buffer.allocate(bytes, alignment);
+}
+
+void TTM::Arena::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+	m_buffer.deallocate(p, bytes, alignment);
+}
+
+bool TTM::Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
+
+void* TTM::Arena::Upstream::do_allocate(size_t bytes, size_t alignment)
+{
+	void* p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	reserved += bytes;
+	++blocks;
+	return p;
+}
+
+void TTM::Arena::Upstream::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+	std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool TTM::Arena::Upstream::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+namespace TTM
+{
+	//   :   ,  -  pmr  ,  , 
+	//         ;     .
+	//   :        pmr  
+	class Arena : public std::pmr::memory_resource
+	{
+	public:
+		Arena();
+		~Arena();
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		//  ;        ,
+		//     
+		size_t used() const { return m_used; }
+		//     -    
+		size_t highWater() const { return m_upstream.reserved; }
+		size_t blocksCount() const { return m_upstream.blocks; }
+
+		//    ,    
+		size_t phaseUsed();
+
+	private:
+		class Upstream : public std::pmr::memory_resource
+		{
+		public:
+			size_t reserved = 0;
+			size_t blocks = 0;
+
+		private:
+			void* do_allocate(size_t bytes, size_t alignment) override;
+			void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+		};
+
+		Upstream m_upstream;
+		std::pmr::monotonic_buffer_resource m_buffer;
+		//     ,     
+		std::pmr::memory_resource* m_previous;
+		size_t m_used = 0;
+		size_t m_mark = 0;
+
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	};
+
+	//     :   ,   
+	template<class T>
+	T* allocateArray(size_t count)
+	{
+		return static_cast<T*>(std::pmr::get_default_resource()->allocate(sizeof(T) * count, alignof(T)));
+	}
+}
@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "BufferedWriter.h"
+#include "Error.h"
+
+TTM::BufferedWriter::BufferedWriter(const char* filePath, size_t bufferSize)
+	: m_file(filePath), m_buffer(bufferSize)
+{	}
+
+TTM::BufferedWriter::~BufferedWriter()
+{
+	//      
+	if (m_size > 0 && m_file)
+		m_file.write(m_buffer.data(), m_size);
+}
+
+void TTM::BufferedWriter::flush()
+{
+	const size_t size = m_size;
+	m_size = 0;
+	writeFile(m_buffer.data(), size);
+	if (!m_file.flush())
+		throw ERROR_THROW(117);
+}
+
+void TTM::BufferedWriter::writeFile(const char* data, size_t size)
+{
+	if (!m_file.is_open() || !m_file.write(data, size))
+		throw ERROR_THROW(117);
+}
+
+TTM::BufferedWriter& TTM::BufferedWriter::operator<<(std::string_view text)
+{
+	if (m_size + text.size() > m_buffer.size())
+	{
+		flush();
+		//      ,  
+		if (text.size() > m_buffer.size())
+		{
+			writeFile(text.data(), text.size());
+			return *this;
+		}
+	}
+
+	std::copy(text.begin(), text.end(), m_buffer.data() + m_size);
+	m_size += text.size();
+	return *this;
+}
+
+TTM::BufferedWriter& TTM::BufferedWriter::operator<<(char c)
+{
+	if (m_size == m_buffer.size())
+		flush();
+
+	m_buffer[m_size++] = c;
+	return *this;
+}
+
+TTM::BufferedWriter& TTM::BufferedWriter::right(std::string_view text, size_t width)
+{
+	padding(width > text.size() ? width - text.size() : 0);
+	return *this << text;
+}
+
+TTM::BufferedWriter& TTM::BufferedWriter::left(std::string_view text, size_t width)
+{
+	*this << text;
+	padding(width > text.size() ? width - text.size() : 0);
+	return *this;
+}
+
+void TTM::BufferedWriter::padding(size_t count)
+{
+	static const char spaces[] = "                                ";
+	while (count > 0)
+	{
+		const size_t part = std::min(count, sizeof(spaces) - 1);
+		*this << std::string_view(spaces, part);
+		count -= part;
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+namespace TTM
+{
+	namespace dump
+	{
+		// text -  ,  ; tsv -   ,  
+		enum class format { text, tsv };
+	}
+
+	//      :   ,      
+	class BufferedWriter
+	{
+	public:
+		static constexpr size_t defaultBufferSize = 1 << 20;
+
+		explicit BufferedWriter(const char* filePath, size_t bufferSize = defaultBufferSize);
+		~BufferedWriter();
+		BufferedWriter(const BufferedWriter&) = delete;
+		BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+		bool isOpen() const { return m_file.is_open(); }
+		//   ;   - ERROR_THROW(117).     ,
+		//  ,   ,  flush 
+		void flush();
+
+		BufferedWriter& operator<<(std::string_view text);
+		BufferedWriter& operator<<(char c);
+
+		template<class Integer, class = std::enable_if_t<std::is_integral<Integer>::value>>
+		BufferedWriter& operator<<(Integer number)
+		{
+			char digits[24];
+			return *this << std::string_view(digits, std::to_chars(digits, digits + sizeof(digits), number).ptr - digits);
+		}
+
+		//   width       ,  std::setw  std::left
+		BufferedWriter& right(std::string_view text, size_t width);
+		BufferedWriter& left(std::string_view text, size_t width);
+
+		template<class Integer, class = std::enable_if_t<std::is_integral<Integer>::value>>
+		BufferedWriter& right(Integer number, size_t width)
+		{
+			char digits[24];
+			return right(std::string_view(digits, std::to_chars(digits, digits + sizeof(digits), number).ptr - digits), width);
+		}
+
+		template<class Integer, class = std::enable_if_t<std::is_integral<Integer>::value>>
+		BufferedWriter& left(Integer number, size_t width)
+		{
+			char digits[24];
+			return left(std::string_view(digits, std::to_chars(digits, digits + sizeof(digits), number).ptr - digits), width);
+		}
+
+	private:
+		std::ofstream m_file;
+		std::vector<char> m_buffer;
+		size_t m_size = 0;
+
+		void padding(size_t count);
+		void writeFile(const char* data, size_t size);
+	};
+}
@@ -0,0 +1,465 @@
+#include "pch.h"
+#include "CharScanner.h"
+#include "InputFileReader.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define TTM_SCAN_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TTM_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define TTM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+	using namespace TTM;
+
+	bool isIdentifierChar(unsigned char c)
+	{
+		return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+	}
+
+	unsigned countTrailingZeros(unsigned mask)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+	const char* findNonIdentifierScalar(const char* begin, const char* end)
+	{
+		while (begin != end && isIdentifierChar(static_cast<unsigned char>(*begin)))
+			++begin;
+		return begin;
+	}
+
+	const char* findQuoteScalar(const char* begin, const char* end)
+	{
+		const void* found = memchr(begin, '\'', end - begin);
+		return found ? static_cast<const char*>(found) : end;
+	}
+
+	const char* findNewlineScalar(const char* begin, const char* end)
+	{
+		const void* found = memchr(begin, in::endl, end - begin);
+		return found ? static_cast<const char*>(found) : end;
+	}
+
+	//    UTF-8   3-7  Unicode; nullptr,   
+	const unsigned char* nextUtf8(const unsigned char* position, const unsigned char* end)
+	{
+		const unsigned char lead = *position;
+		if (lead < 0x80)
+			return position + 1;
+
+		ptrdiff_t length = 0;
+		unsigned char low = 0x80, high = 0xBF;
+		if (lead >= 0xC2 && lead <= 0xDF)
+			length = 2;
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			length = 3;
+			if (lead == 0xE0)
+				low = 0xA0;
+			else if (lead == 0xED)
+				high = 0x9F;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			length = 4;
+			if (lead == 0xF0)
+				low = 0x90;
+			else if (lead == 0xF4)
+				high = 0x8F;
+		}
+		else
+			return nullptr;
+
+		if (end - position < length || position[1] < low || position[1] > high)
+			return nullptr;
+		for (ptrdiff_t i = 2; i < length; ++i)
+			if ((position[i] & 0xC0) != 0x80)
+				return nullptr;
+
+		return position + length;
+	}
+
+	const char* findInvalidUtf8Scalar(const char* begin, const char* end)
+	{
+		const unsigned char* position = reinterpret_cast<const unsigned char*>(begin);
+		const unsigned char* const last = reinterpret_cast<const unsigned char*>(end);
+
+		while (position != last)
+		{
+			// ASCII    8 
+			unsigned long long word;
+			if (last - position >= 8 && (memcpy(&word, position, 8), (word & 0x8080808080808080ULL) == 0))
+			{
+				position += 8;
+				continue;
+			}
+
+			const unsigned char* next = nextUtf8(position, last);
+			if (next == nullptr)
+				return reinterpret_cast<const char*>(position);
+			position = next;
+		}
+
+		return end;
+	}
+
+	bool validateUtf8Scalar(const char* begin, const char* end)
+	{
+		return findInvalidUtf8Scalar(begin, end) == end;
+	}
+
+#ifdef TTM_SCAN_X86
+
+	//  [lo, lo + count)        -128
+	__m128i inRange128(__m128i v, char lo, char count)
+	{
+		__m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - lo)));
+		return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + count)));
+	}
+
+	unsigned identifierMask128(__m128i v)
+	{
+		__m128i digit = inRange128(v, '0', 10);
+		__m128i alpha = inRange128(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 26);
+		return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(digit, alpha)));
+	}
+
+	const char* findNonIdentifierSse2(const char* begin, const char* end)
+	{
+		for (; end - begin >= 16; begin += 16)
+		{
+			unsigned mask = ~identifierMask128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin))) & 0xffff;
+			if (mask != 0)
+				return begin + countTrailingZeros(mask);
+		}
+		return findNonIdentifierScalar(begin, end);
+	}
+
+	const char* findByteSse2(const char* begin, const char* end, char c)
+	{
+		const __m128i needle = _mm_set1_epi8(c);
+		for (; end - begin >= 16; begin += 16)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+			unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)));
+			if (mask != 0)
+				return begin + countTrailingZeros(mask);
+		}
+		while (begin != end && *begin != c)
+			++begin;
+		return begin;
+	}
+
+	const char* findQuoteSse2(const char* begin, const char* end)
+	{
+		return findByteSse2(begin, end, '\'');
+	}
+
+	const char* findNewlineSse2(const char* begin, const char* end)
+	{
+		return findByteSse2(begin, end, in::endl);
+	}
+
+	bool validateUtf8Sse2(const char* begin, const char* end)
+	{
+		const unsigned char* position = reinterpret_cast<const unsigned char*>(begin);
+		const unsigned char* const last = reinterpret_cast<const unsigned char*>(end);
+
+		//    ASCII  ,     
+		while (position != last)
+		{
+			if (last - position >= 16 && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(position))) == 0)
+			{
+				position += 16;
+				continue;
+			}
+
+			position = nextUtf8(position, last);
+			if (position == nullptr)
+				return false;
+		}
+
+		return true;
+	}
+
+	TTM_TARGET_AVX2 __m256i inRange256(__m256i v, char lo, char count)
+	{
+		__m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(0x80 - lo)));
+		return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + count)), shifted);
+	}
+
+	TTM_TARGET_AVX2 const char* findNonIdentifierAvx2(const char* begin, const char* end)
+	{
+		for (; end - begin >= 32; begin += 32)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+			__m256i digit = inRange256(v, '0', 10);
+			__m256i alpha = inRange256(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 26);
+			unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(digit, alpha)));
+			if (mask != 0)
+				return begin + countTrailingZeros(mask);
+		}
+		return findNonIdentifierSse2(begin, end);
+	}
+
+	TTM_TARGET_AVX2 const char* findByteAvx2(const char* begin, const char* end, char c)
+	{
+		const __m256i needle = _mm256_set1_epi8(c);
+		for (; end - begin >= 32; begin += 32)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+			unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+			if (mask != 0)
+				return begin + countTrailingZeros(mask);
+		}
+		return findByteSse2(begin, end, c);
+	}
+
+	const char* findQuoteAvx2(const char* begin, const char* end)
+	{
+		return findByteAvx2(begin, end, '\'');
+	}
+
+	const char* findNewlineAvx2(const char* begin, const char* end)
+	{
+		return findByteAvx2(begin, end, in::endl);
+	}
+
+	//  UTF-8  Keiser  Lemire:       
+	//   ,         
+	namespace utf8
+	{
+		enum : unsigned char
+		{
+			tooShort = 1 << 0, tooLong = 1 << 1, overlong3 = 1 << 2, tooLarge = 1 << 3,
+			surrogate = 1 << 4, overlong2 = 1 << 5, tooLarge1000 = 1 << 6, overlong4 = 1 << 6,
+			twoContinuations = 1 << 7,
+			carry = tooShort | tooLong | twoContinuations
+		};
+
+		alignas(16) const unsigned char byte1High[16] = {
+			tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong,
+			twoContinuations, twoContinuations, twoContinuations, twoContinuations,
+			tooShort | overlong2,
+			tooShort,
+			tooShort | overlong3 | surrogate,
+			tooShort | tooLarge | tooLarge1000 | overlong4
+		};
+
+		alignas(16) const unsigned char byte1Low[16] = {
+			carry | overlong3 | overlong2 | overlong4,
+			carry | overlong2,
+			carry,
+			carry,
+			carry | tooLarge,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000 | surrogate,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000
+		};
+
+		alignas(16) const unsigned char byte2High[16] = {
+			tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort,
+			tooLong | overlong2 | twoContinuations | overlong3 | tooLarge1000 | overlong4,
+			tooLong | overlong2 | twoContinuations | overlong3 | tooLarge,
+			tooLong | overlong2 | twoContinuations | surrogate | tooLarge,
+			tooLong | overlong2 | twoContinuations | surrogate | tooLarge,
+			tooShort, tooShort, tooShort, tooShort
+		};
+
+		// ,    ,    
+		alignas(32) const unsigned char incompleteMax[32] = {
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+		};
+
+		struct State
+		{
+			__m256i error;
+			__m256i previous;
+			__m256i previousIncomplete;
+		};
+	}
+
+	template<int N>
+	TTM_TARGET_AVX2 __m256i previousBytes256(__m256i input, __m256i previous)
+	{
+		return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+	}
+
+	TTM_TARGET_AVX2 __m256i lookup256(const unsigned char (&table)[16], __m256i nibbles)
+	{
+		return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table))), nibbles);
+	}
+
+	TTM_TARGET_AVX2 void validateUtf8Block(__m256i input, utf8::State& state)
+	{
+		if (_mm256_movemask_epi8(input) == 0)
+		{
+			state.error = _mm256_or_si256(state.error, state.previousIncomplete);
+			state.previous = input;
+			return;
+		}
+
+		const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+		const __m256i previous1 = previousBytes256<1>(input, state.previous);
+		const __m256i special = _mm256_and_si256(
+			_mm256_and_si256(
+				lookup256(utf8::byte1High, _mm256_and_si256(_mm256_srli_epi16(previous1, 4), lowNibble)),
+				lookup256(utf8::byte1Low, _mm256_and_si256(previous1, lowNibble))),
+			lookup256(utf8::byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibble)));
+
+		const __m256i third = _mm256_subs_epu8(previousBytes256<2>(input, state.previous), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+		const __m256i fourth = _mm256_subs_epu8(previousBytes256<3>(input, state.previous), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+		const __m256i mustBeContinuation = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+		state.error = _mm256_or_si256(state.error, _mm256_xor_si256(mustBeContinuation, special));
+		state.previousIncomplete = _mm256_subs_epu8(input, _mm256_load_si256(reinterpret_cast<const __m256i*>(utf8::incompleteMax)));
+		state.previous = input;
+	}
+
+	TTM_TARGET_AVX2 bool validateUtf8Avx2(const char* begin, const char* end)
+	{
+		utf8::State state = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+
+		for (; end - begin >= 32; begin += 32)
+			validateUtf8Block(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin)), state);
+
+		if (begin != end)
+		{
+			alignas(32) char tail[32] = {};
+			memcpy(tail, begin, end - begin);
+			validateUtf8Block(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)), state);
+		}
+
+		state.error = _mm256_or_si256(state.error, state.previousIncomplete);
+		return _mm256_testz_si256(state.error, state.error) != 0;
+	}
+
+	void cpuid(int info[4], int function)
+	{
+#ifdef _MSC_VER
+		__cpuidex(info, function, 0);
+#else
+		unsigned a, b, c, d;
+		__cpuid_count(function, 0, a, b, c, d);
+		info[0] = static_cast<int>(a);
+		info[1] = static_cast<int>(b);
+		info[2] = static_cast<int>(c);
+		info[3] = static_cast<int>(d);
+#endif
+	}
+
+	bool cpuHasSse2()
+	{
+		int info[4];
+		cpuid(info, 1);
+		return (info[3] & (1 << 26)) != 0;
+	}
+
+	bool cpuHasAvx2()
+	{
+		int info[4];
+		cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		// AVX2  ,      YMM (OSXSAVE + XCR0)
+		cpuid(info, 1);
+		if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+			return false;
+#ifdef _MSC_VER
+		unsigned long long xcr0 = _xgetbv(0);
+#else
+		unsigned eax, edx;
+		__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		unsigned long long xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+		if ((xcr0 & 6) != 6)
+			return false;
+
+		cpuid(info, 7);
+		return (info[1] & (1 << 5)) != 0;
+	}
+
+#endif
+
+	const scan::Scanner scanners[] = {
+		{ scan::level::scalar, findNonIdentifierScalar, findQuoteScalar, findNewlineScalar, validateUtf8Scalar },
+#ifdef TTM_SCAN_X86
+		{ scan::level::sse2, findNonIdentifierSse2, findQuoteSse2, findNewlineSse2, validateUtf8Sse2 },
+		{ scan::level::avx2, findNonIdentifierAvx2, findQuoteAvx2, findNewlineAvx2, validateUtf8Avx2 },
+#endif
+	};
+
+	const scan::Scanner* activeScanner = nullptr;
+}
+
+TTM::scan::level TTM::scan::bestLevel()
+{
+#ifdef TTM_SCAN_X86
+	static const level best = cpuHasAvx2() ? level::avx2 : cpuHasSse2() ? level::sse2 : level::scalar;
+	return best;
+#else
+	return level::scalar;
+#endif
+}
+
+const TTM::scan::Scanner& TTM::scan::getScanner(level scanLevel)
+{
+	if (static_cast<int>(scanLevel) > static_cast<int>(bestLevel()))
+		scanLevel = bestLevel();
+
+	return scanners[static_cast<int>(scanLevel)];
+}
+
+const TTM::scan::Scanner& TTM::scan::scanner()
+{
+	if (activeScanner == nullptr)
+		activeScanner = &getScanner(bestLevel());
+
+	return *activeScanner;
+}
+
+void TTM::scan::setLevel(level scanLevel)
+{
+	activeScanner = &getScanner(scanLevel);
+}
+
+const char* TTM::scan::levelName(level scanLevel)
+{
+	switch (scanLevel)
+	{
+	case level::sse2:
+		return "sse2";
+	case level::avx2:
+		return "avx2";
+	default:
+		return "scalar";
+	}
+}
+
+const char* TTM::scan::findInvalidUtf8(const char* begin, const char* end)
+{
+	return findInvalidUtf8Scalar(begin, end);
+}
\ No newline at end of file
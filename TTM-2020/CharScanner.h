@@ -0,0 +1,36 @@
+#pragma once
+
+namespace TTM
+{
+	namespace scan
+	{
+		//    ,       
+		enum class level { scalar, sse2, avx2 };
+
+		struct Scanner
+		{
+			level scanLevel;
+
+			//  ,      (in::T): [0-9A-Za-z]
+			const char* (*findNonIdentifier)(const char* begin, const char* end);
+			//   in::Q
+			const char* (*findQuote)(const char* begin, const char* end);
+			//   in::endl
+			const char* (*findNewline)(const char* begin, const char* end);
+			//    UTF-8:  ,    
+			bool (*validateUtf8)(const char* begin, const char* end);
+		};
+
+		level bestLevel();
+		const Scanner& getScanner(level scanLevel);
+
+		//   ,   bestLevel()
+		const Scanner& scanner();
+		void setLevel(level scanLevel);
+
+		const char* levelName(level scanLevel);
+
+		//     UTF-8  end,    
+		const char* findInvalidUtf8(const char* begin, const char* end);
+	}
+}
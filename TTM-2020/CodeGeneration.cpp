@@ -7,6 +7,8 @@ TTM::Generator::Generator(LexTable& lextable, IdTable& idtable, const char* outF
 
 void TTM::Generator::Start(Logger& log)
 {
+	m_fullNames.assign(idtable.size(), std::pmr::string{});
+
 	Head();
 	Constants();
 	Data();
@@ -41,7 +43,22 @@ void TTM::Generator::Constants()
 			}
 			else if (idtable[i].dataType == it::data_type::str)
 			{
-				outFile << " BYTE " << idtable[i].value.strValue.string << ", 0";
+				//     ,     MASM :
+				//      BYTE 
+				const std::string_view text = idtable.stringValue(i);
+				if (text.size() - 2 <= stringChunkSize)
+				{
+					outFile << " BYTE " << text << ", 0";
+				}
+				else
+				{
+					const std::string_view body = text.substr(1, text.size() - 2);
+					for (size_t offset = 0; offset < body.size(); offset += stringChunkSize)
+					{
+						outFile << (offset ? "\n BYTE '" : " BYTE '") << body.substr(offset, stringChunkSize) << '\'';
+					}
+					outFile << ", 0";
+				}
 			}
 			outFile << '\n';
 		}
@@ -68,24 +85,24 @@ void TTM::Generator::Code()
 
 	for (int i = 0; i < lextable.size(); ++i)
 	{
-		switch (lextable[i].lexeme)
+		switch (lextable.lexeme(i))
 		{
 		case LEX_ASSIGN:
 			outFile << doOperations(i + 1);
-			outFile << "pop " << getFullName(lextable[i - 1].idTableIndex) << '\n';
+			outFile << "pop " << getFullName(lextable.idTableIndex(i - 1)) << '\n';
 			break;
 
 		case LEX_FN:
 		case LEX_MAIN:
-			lastFunctionName = getFullName(lextable[i + 2].idTableIndex);
+			lastFunctionName = getFullName(lextable.idTableIndex(i + 2));
 			outFile << lastFunctionName << " PROC ";
-			while (lextable[i].lexeme != LEX_CLOSING_PARENTHESIS)
+			while (lextable.lexeme(i) != LEX_CLOSING_PARENTHESIS)
 			{
-				if (lextable[i].lexeme == LEX_ID && idtable[lextable[i].idTableIndex].idType != it::id_type::function)
+				if (lextable.lexeme(i) == LEX_ID && idtable[lextable.idTableIndex(i)].idType != it::id_type::function)
 				{
 					parametersCount += 4;
-					outFile << getFullName(lextable[i].idTableIndex) << " : SDWORD";
-					if (lextable[i + 1].lexeme != LEX_CLOSING_PARENTHESIS)
+					outFile << getFullName(lextable.idTableIndex(i)) << " : SDWORD";
+					if (lextable.lexeme(i + 1) != LEX_CLOSING_PARENTHESIS)
 						outFile << ", ";
 				}
 
@@ -112,8 +129,8 @@ void TTM::Generator::Code()
 			else
 			{
 				outFile << "pop ";
-				if (lextable[i + 1].lexeme == LEX_LITERAL
-					&& idtable[lextable[i + 1].idTableIndex].dataType == it::data_type::str
+				if (lextable.lexeme(i + 1) == LEX_LITERAL
+					&& idtable[lextable.idTableIndex(i + 1)].dataType == it::data_type::str
 					&& !isArgumentOfFunction(i + 1))
 				{
 					outFile << "offset ";
@@ -136,30 +153,30 @@ void TTM::Generator::Code()
 
 int TTM::Generator::writeIf(int startIndex)
 {
-	outFile << ".if " << getFullName(lextable[startIndex + 1].idTableIndex) << " != 0\n";
+	outFile << ".if " << getFullName(lextable.idTableIndex(startIndex + 1)) << " != 0\n";
 
 	int i = 0;
-	for (i = startIndex; lextable[i].lexeme != LEX_CLOSING_CURLY_BRACE; ++i)
+	for (i = startIndex; lextable.lexeme(i) != LEX_CLOSING_CURLY_BRACE; ++i)
 	{
-		if (lextable[i].lexeme == LEX_ASSIGN) {
+		if (lextable.lexeme(i) == LEX_ASSIGN) {
 			outFile << doOperations(i + 1);
-			outFile << "pop " << getFullName(lextable[i - 1].idTableIndex) << '\n';
+			outFile << "pop " << getFullName(lextable.idTableIndex(i - 1)) << '\n';
 		}
-		else if (lextable[i].lexeme == LEX_ECHO)
+		else if (lextable.lexeme(i) == LEX_ECHO)
 		{
 			writeEcho(i);
 		}
 	}
-	if (lextable[i + 1].lexeme == LEX_ELSE)
+	if (lextable.lexeme(i + 1) == LEX_ELSE)
 	{
 		outFile << ".else\n";
-		for (i = i + 1; lextable[i].lexeme != LEX_CLOSING_CURLY_BRACE; ++i)
+		for (i = i + 1; lextable.lexeme(i) != LEX_CLOSING_CURLY_BRACE; ++i)
 		{
-			if (lextable[i].lexeme == LEX_ASSIGN) {
+			if (lextable.lexeme(i) == LEX_ASSIGN) {
 				outFile << doOperations(i + 1);
-				outFile << "pop " << getFullName(lextable[i - 1].idTableIndex) << '\n';
+				outFile << "pop " << getFullName(lextable.idTableIndex(i - 1)) << '\n';
 			}
-			else if (lextable[i].lexeme == LEX_ECHO)
+			else if (lextable.lexeme(i) == LEX_ECHO)
 			{
 				writeEcho(i);
 			}
@@ -172,32 +189,35 @@ int TTM::Generator::writeIf(int startIndex)
 
 void TTM::Generator::writeEcho(int startIndex)
 {
-	for (int i = startIndex; lextable[i].lexeme != LEX_SEMICOLON; ++i)
+	for (int i = startIndex; lextable.lexeme(i) != LEX_SEMICOLON; ++i)
 	{
-		if (lextable[i + 1].lexeme == LEX_ID || lextable[i + 1].lexeme == LEX_LITERAL)
+		if (lextable.lexeme(i + 1) == LEX_ID || lextable.lexeme(i + 1) == LEX_LITERAL)
 		{
-			if (idtable[lextable[i + 1].idTableIndex].dataType == it::data_type::i32)
+			if (idtable[lextable.idTableIndex(i + 1)].dataType == it::data_type::i32)
 			{
-				outFile << "push " << getFullName(lextable[i + 1].idTableIndex)
+				outFile << "push " << getFullName(lextable.idTableIndex(i + 1))
 					<< "\ncall _echoInt\n";
 			}
-			else if (idtable[lextable[i + 1].idTableIndex].dataType == it::data_type::str)
+			else if (idtable[lextable.idTableIndex(i + 1)].dataType == it::data_type::str)
 			{
 				outFile << "push ";
-				if (lextable[i + 1].lexeme == LEX_LITERAL)
+				if (lextable.lexeme(i + 1) == LEX_LITERAL)
 				{
 					outFile << "offset ";
 				}
-				outFile << getFullName(lextable[i + 1].idTableIndex)
+				outFile << getFullName(lextable.idTableIndex(i + 1))
 					<< "\ncall _echoStr\n";
 			}
 		}
 	}
 }
 
-std::string TTM::Generator::getFullName(int index)
+const std::pmr::string& TTM::Generator::getFullName(int index)
 {
-	return '_' + idtable[index].scope + idtable[index].name;
+	std::pmr::string& fullName = m_fullNames[index];
+	if (fullName.empty())
+		fullName.append(1, '_').append(idtable.scope(index)).append(idtable.name(index));
+	return fullName;
 }
 
 std::string TTM::Generator::includeStdlib()
@@ -215,11 +235,11 @@ std::string TTM::Generator::includeStdlib()
 
 int TTM::Generator::getFunctionCallIndex(int startIndex)
 {
-	for (int i = startIndex; lextable[i].lexeme != LEX_SEMICOLON && lextable[i].lexeme != LEX_PLUS
-		&& lextable[i].lexeme != LEX_MINUS && lextable[i].lexeme != LEX_ASTERISK
-		&& lextable[i].lexeme != LEX_SLASH && lextable[i].lexeme != LEX_PERCENT; ++i)
+	for (int i = startIndex; lextable.lexeme(i) != LEX_SEMICOLON && lextable.lexeme(i) != LEX_PLUS
+		&& lextable.lexeme(i) != LEX_MINUS && lextable.lexeme(i) != LEX_ASTERISK
+		&& lextable.lexeme(i) != LEX_SLASH && lextable.lexeme(i) != LEX_PERCENT; ++i)
 	{
-		if (lextable[i].lexeme == LEX_FUNCTION_CALL)
+		if (lextable.lexeme(i) == LEX_FUNCTION_CALL)
 		{
 			return i;
 		}
@@ -233,7 +253,7 @@ bool TTM::Generator::isArgumentOfFunction(int index)
 	int functionCallIndex = getFunctionCallIndex(index);
 	if (functionCallIndex != TI_NULLIDX)
 	{
-		int parametersCount = lextable[functionCallIndex + 1].lexeme - '0';
+		int parametersCount = lextable.idTableIndex(functionCallIndex + 1);
 		return (functionCallIndex - parametersCount) == index;
 	}
 
@@ -244,60 +264,60 @@ std::string TTM::Generator::doOperations(int startIndex)
 {
 	std::stringstream output;
 
-	for (int i = startIndex; lextable[i].lexeme != LEX_SEMICOLON; ++i)
+	for (int i = startIndex; lextable.lexeme(i) != LEX_SEMICOLON; ++i)
 	{
-		if (lextable[i].lexeme == LEX_FUNCTION_CALL)
+		if (lextable.lexeme(i) == LEX_FUNCTION_CALL)
 		{
-			output << "invoke " << getFullName(lextable[i].idTableIndex);
-			int argumentsCount = lextable[i + 1].lexeme - '0';
+			output << "invoke " << getFullName(lextable.idTableIndex(i));
+			int argumentsCount = lextable.idTableIndex(i + 1);
 
 			for (int j = argumentsCount; j > 0; --j)
 			{
 				output << ", ";
-				if (lextable[i - j].lexeme == LEX_LITERAL && idtable[lextable[i - j].idTableIndex].dataType == it::data_type::str)
+				if (lextable.lexeme(i - j) == LEX_LITERAL && idtable[lextable.idTableIndex(i - j)].dataType == it::data_type::str)
 				{
 					output << "offset ";
 				}
-				output << getFullName(lextable[i - j].idTableIndex);
+				output << getFullName(lextable.idTableIndex(i - j));
 			}
 			output << "\npush eax\n";
 		}
-		else if (lextable[i].lexeme == LEX_ID && !isArgumentOfFunction(i))
+		else if (lextable.lexeme(i) == LEX_ID && !isArgumentOfFunction(i))
 		{
-			output << "push " << getFullName(lextable[i].idTableIndex) << '\n';
+			output << "push " << getFullName(lextable.idTableIndex(i)) << '\n';
 		}
-		else if (lextable[i].lexeme == LEX_LITERAL && !isArgumentOfFunction(i))
+		else if (lextable.lexeme(i) == LEX_LITERAL && !isArgumentOfFunction(i))
 		{
 			output << "push ";
-			if (idtable[lextable[i].idTableIndex].dataType == it::data_type::str)
+			if (idtable[lextable.idTableIndex(i)].dataType == it::data_type::str)
 			{
 				output << "offset ";
 			}
 
-			output << getFullName(lextable[i].idTableIndex) << '\n';
+			output << getFullName(lextable.idTableIndex(i)) << '\n';
 		}
-		else if (lextable[i].lexeme == LEX_PLUS)
+		else if (lextable.lexeme(i) == LEX_PLUS)
 		{
 			output << "pop eax\n"
 				<< "pop ebx\n"
 				<< "add eax, ebx\n"
 				<< "push eax\n";
 		}
-		else if (lextable[i].lexeme == LEX_MINUS)
+		else if (lextable.lexeme(i) == LEX_MINUS)
 		{
 			output << "pop ebx\n"
 				<< "pop eax\n"
 				<< "sub eax, ebx\n"
 				<< "push eax\n";
 		}
-		else if (lextable[i].lexeme == LEX_ASTERISK)
+		else if (lextable.lexeme(i) == LEX_ASTERISK)
 		{
 			output << "pop eax\n"
 				<< "pop ebx\n"
 				<< "mul ebx\n"
 				<< "push eax\n";
 		}
-		else if (lextable[i].lexeme == LEX_SLASH)
+		else if (lextable.lexeme(i) == LEX_SLASH)
 		{
 			output << "pop ebx\n"
 				<< "mov edx, 0\n"
@@ -310,7 +330,7 @@ std::string TTM::Generator::doOperations(int startIndex)
 				<< "idiv ebx\n"
 				<< "push eax\n";
 		}
-		else if (lextable[i].lexeme == LEX_PERCENT)
+		else if (lextable.lexeme(i) == LEX_PERCENT)
 		{
 			output << "pop ebx\n"
 				<< "mov edx, 0\n"
@@ -16,14 +16,18 @@ namespace TTM
 		LexTable& lextable;
 		IdTable& idtable;
 		std::ofstream outFile;
+		//          
+		std::pmr::vector<std::pmr::string> m_fullNames;
 
 		const char* stdlibPath = "../Debug/stdlib.lib";
+		//        BYTE
+		static constexpr size_t stringChunkSize = 200;
 		void Head();
 		void Constants();
 		void Data();
 		void Code();
 
-		std::string getFullName(int index);
+		const std::pmr::string& getFullName(int index);
 		std::string includeStdlib();
 		std::string doOperations(int startIndex);
 
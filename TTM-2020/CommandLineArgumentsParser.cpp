@@ -33,6 +33,18 @@ TTM::CommandLineArgumentsParser::CommandLineArgumentsParser(int argc, char** arg
 	{
 		m_rulesPath = m_inFilePath + '.' + rulesKey + ".txt";
 	}
+	m_utf8 = optionExists(argv + 1, argv + argc, delimiter + utf8Key);
+	m_tsv = optionExists(argv + 1, argv + argc, delimiter + tsvKey);
+	m_ll1 = optionExists(argv + 1, argv + argc, delimiter + ll1Key);
+
+	m_snapshotPath = m_inFilePath + '.' + snapshotExtension;
+	m_snapshot = optionExists(argv + 1, argv + argc, delimiter + snapshotKey);
+	if (m_snapshot)
+	{
+		char* phase = getOption(argv + 1, argv + argc, delimiter + snapshotKey);
+		m_snapshotPhase = (phase == nullptr) ? "" : phase;
+	}
+	m_resume = optionExists(argv + 1, argv + argc, delimiter + resumeKey);
 }
 
 std::vector<std::string> TTM::CommandLineArgumentsParser::getAllParameters() const
@@ -58,6 +70,26 @@ std::vector<std::string> TTM::CommandLineArgumentsParser::getAllParameters() con
 	{
 		parameters.push_back(delimiter + rulesKey + " " + m_rulesPath);
 	}
+	if (m_utf8)
+	{
+		parameters.push_back(delimiter + utf8Key);
+	}
+	if (m_tsv)
+	{
+		parameters.push_back(delimiter + tsvKey);
+	}
+	if (m_ll1)
+	{
+		parameters.push_back(delimiter + ll1Key);
+	}
+	if (m_snapshot)
+	{
+		parameters.push_back(delimiter + snapshotKey + " " + m_snapshotPhase + " " + m_snapshotPath);
+	}
+	if (m_resume)
+	{
+		parameters.push_back(delimiter + resumeKey + " " + m_snapshotPath);
+	}
 	return parameters;
 }
 
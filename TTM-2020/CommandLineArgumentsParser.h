@@ -12,9 +12,23 @@ namespace TTM
 		const char* outFilePath() const { return m_outFilePath.c_str(); }
 		const char* logFilePath() const { return m_logFilePath.c_str(); }
 		const char* lexTableFilePath() const { return m_lexTablePath.c_str(); }
+		bool lexTable() const { return !m_lexTablePath.empty(); }
 		const char* idTableFilePath() const { return m_idTablePath.c_str(); }
+		bool idTable() const { return !m_idTablePath.empty(); }
 		const char* traceFilePath() const { return m_tracePath.c_str(); }
+		bool trace() const { return !m_tracePath.empty(); }
 		const char* rulesFilePath() const { return m_rulesPath.c_str(); }
+		bool rules() const { return !m_rulesPath.empty(); }
+		bool utf8() const { return m_utf8; }
+		//      ,   
+		bool tsv() const { return m_tsv; }
+		//   LL(1)    
+		bool ll1() const { return m_ll1; }
+		//   <in>.snap: -snapshot <>  , -resume   
+		const char* snapshotFilePath() const { return m_snapshotPath.c_str(); }
+		bool snapshot() const { return m_snapshot; }
+		const std::string& snapshotPhase() const { return m_snapshotPhase; }
+		bool resume() const { return m_resume; }
 
 		std::vector<std::string> getAllParameters() const;
 
@@ -27,6 +41,12 @@ namespace TTM
 		const std::string idKey = "id";
 		const std::string traceKey = "trace";
 		const std::string rulesKey = "rules";
+		const std::string utf8Key = "utf8";
+		const std::string tsvKey = "tsv";
+		const std::string ll1Key = "ll1";
+		const std::string snapshotKey = "snapshot";
+		const std::string resumeKey = "resume";
+		const std::string snapshotExtension = "snap";
 
 		std::string m_inFilePath;
 		std::string m_outFilePath;
@@ -35,6 +55,13 @@ namespace TTM
 		std::string m_idTablePath;
 		std::string m_tracePath;
 		std::string m_rulesPath;
+		bool m_utf8 = false;
+		bool m_tsv = false;
+		bool m_ll1 = false;
+		std::string m_snapshotPath;
+		bool m_snapshot = false;
+		std::string m_snapshotPhase;
+		bool m_resume = false;
 
 		static bool optionExists(char** begin, char** end, std::string option);
 		static char* getOption(char** begin, char** end, std::string option);
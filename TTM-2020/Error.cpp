@@ -18,15 +18,20 @@ ERROR errors[ERROR_MAX_ENTRY] = {
 	ERROR_ENTRY_NODEF10(50),
 	ERROR_ENTRY_NODEF10(60), ERROR_ENTRY_NODEF10(70), ERROR_ENTRY_NODEF10(80), ERROR_ENTRY_NODEF10(90),
 	ERROR_ENTRY(100, " -in   "),
-	ERROR_ENTRY_NODEF(101), ERROR_ENTRY_NODEF(102), ERROR_ENTRY_NODEF(103),
+	ERROR_ENTRY(101, "    -snapshot (lex, syntax, semantic, polish)"),
+	ERROR_ENTRY_NODEF(102), ERROR_ENTRY_NODEF(103),
 	ERROR_ENTRY_NODEF(104),
 	ERROR_ENTRY_NODEF(105), ERROR_ENTRY_NODEF(106), ERROR_ENTRY_NODEF(107),
 	ERROR_ENTRY_NODEF(108), ERROR_ENTRY_NODEF(109),
 	ERROR_ENTRY(110, "       (-in)"),
 	ERROR_ENTRY(111, "     (-in)"),
 	ERROR_ENTRY(112, "     (-log)"),
-	ERROR_ENTRY_NODEF(113), ERROR_ENTRY_NODEF(114), ERROR_ENTRY_NODEF(115),
-	ERROR_ENTRY_NODEF(116), ERROR_ENTRY_NODEF(117), ERROR_ENTRY_NODEF(118), ERROR_ENTRY_NODEF(119),
+	ERROR_ENTRY(113, "  UTF-8    (-in)"),
+	ERROR_ENTRY(114, "     (-resume)"),
+	ERROR_ENTRY(115, "       (-resume)"),
+	ERROR_ENTRY(116, "     (-snapshot)"),
+	ERROR_ENTRY(117, "       (-lex, -id, -trace, -rules)"),
+	ERROR_ENTRY_NODEF(118), ERROR_ENTRY_NODEF(119),
 	ERROR_ENTRY(120, "  "),
 	ERROR_ENTRY(121, "  "),
 	ERROR_ENTRY(122, "  "),
@@ -40,7 +45,8 @@ ERROR errors[ERROR_MAX_ENTRY] = {
 	ERROR_ENTRY(130, "  "),
 	ERROR_ENTRY(131, "  "),
 	ERROR_ENTRY(132, "  "),
-	ERROR_ENTRY_NODEF(133), ERROR_ENTRY_NODEF(134), ERROR_ENTRY_NODEF(135),
+	ERROR_ENTRY(133, "   "),
+	ERROR_ENTRY_NODEF(134), ERROR_ENTRY_NODEF(135),
 	ERROR_ENTRY_NODEF(136), ERROR_ENTRY_NODEF(137), ERROR_ENTRY_NODEF(138),	ERROR_ENTRY_NODEF(139),
 	ERROR_ENTRY_NODEF10(140), ERROR_ENTRY_NODEF10(150),
 	ERROR_ENTRY_NODEF10(160), ERROR_ENTRY_NODEF10(170), ERROR_ENTRY_NODEF10(180), ERROR_ENTRY_NODEF10(190),
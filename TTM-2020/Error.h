@@ -22,8 +22,8 @@ namespace Error
 		int id = 0;
 		std::string message;
 		struct in {
-			short line;
-			short col;
+			int line;
+			int col;
 		} inext = {};
 	};
 
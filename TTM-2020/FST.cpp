@@ -20,65 +20,148 @@ FST::NODE::NODE(short n, RELATION rel, ...)
 }
 
 FST::FST::FST(short ns, NODE n, ...)
-	: position(-1), nstates(ns)
+	: nstates(ns)
 {
 	nodes = DBG_NEW NODE[ns];
 	NODE* p = &n;
 
 	for (int i = 0; i < ns; ++i)
 		nodes[i] = p[i];
+}
 
-	rstates = DBG_NEW short[nstates];
-	memset(rstates, 0xff, sizeof(short) * nstates);
-	rstates[0] = 0;
+FST::FST::FST(std::string_view spelling)
+	: nstates(static_cast<short>(spelling.size() + 1))
+{
+	nodes = DBG_NEW NODE[nstates];
+	for (short i = 0; i < nstates - 1; ++i)
+	{
+		nodes[i].n_relation = 1;
+		nodes[i].relations = DBG_NEW RELATION[1];
+		nodes[i].relations[0] = RELATION(spelling[i], i + 1);
+	}
 }
 
 FST::FST::~FST()
 {
 	for (int i = 0; i < nstates; ++i)
 	{
-		delete nodes[i].relations;
+		delete[] nodes[i].relations;
 		nodes[i].relations = nullptr;
 	}
 
 	delete[] nodes;
 	nodes = nullptr;
-
-	delete[] rstates;
-	rstates = nullptr;
 }
 
-bool step(std::string str, FST::FST& fst, short*& rstates)
+FST::DFA::DFA(const FST* const* fsts, const char* lexemes, int count)
 {
-	bool output = false;
-
-	std::swap(rstates, fst.rstates);
-	for (short i = 0; i < fst.nstates; ++i)
-		if (rstates[i] == fst.position)
-			for (short j = 0; j < fst.nodes[i].n_relation; ++j)
-				if (fst.nodes[i].relations[j].symbol == str[fst.position])
-				{
-					fst.rstates[fst.nodes[i].relations[j].nnode] = fst.position + 1;
-					output = true;
-				}
-
-	return output;
-}
+	//  -    ( FST,  );   - 
+	using subset = std::vector<std::pair<int, int>>;
+	std::map<subset, short> ids;
+	std::vector<subset> subsets;
+	std::vector<short> transitions;
 
-bool FST::execute(std::string str, FST& fst)
-{
-	short* rstates = DBG_NEW short[fst.nstates];
-	short lstring = (short)str.size();
-	bool output = true;
+	auto getId = [&](const subset& s)
+	{
+		auto found = ids.find(s);
+		if (found != ids.end())
+			return found->second;
+
+		const short id = static_cast<short>(subsets.size());
+		ids.emplace(s, id);
+		subsets.push_back(s);
+		return id;
+	};
+
+	subset start;
+	for (int i = 0; i < count; ++i)
+		start.push_back({ i, 0 });
+	getId({});
+	getId(start);
+
+	for (size_t current = 0; current < subsets.size(); ++current)
+	{
+		subset next[256];
+		for (const auto& state : subsets[current])
+		{
+			const NODE& node = fsts[state.first]->nodes[state.second];
+			for (short j = 0; j < node.n_relation; ++j)
+				next[static_cast<unsigned char>(node.relations[j].symbol)].push_back({ state.first, node.relations[j].nnode });
+		}
+
+		for (int c = 0; c < 256; ++c)
+		{
+			std::sort(next[c].begin(), next[c].end());
+			next[c].erase(std::unique(next[c].begin(), next[c].end()), next[c].end());
+			transitions.push_back(getId(next[c]));
+		}
+	}
 
-	memset(rstates, 0xff, sizeof(short) * fst.nstates);
+	// FST  ,       
+	std::vector<char> accept(subsets.size(), EOF);
+	for (size_t i = 0; i < subsets.size(); ++i)
+	{
+		for (const auto& state : subsets[i])
+		{
+			if (state.second == fsts[state.first]->nstates - 1)
+			{
+				accept[i] = lexemes[state.first];
+				break;
+			}
+		}
+	}
 
-	for (short i = 0; i < lstring && output; ++i)
+	//  :     ,    ,  
+	std::vector<int> classes(subsets.size());
+	int classesCount = 0;
 	{
-		fst.position++;
-		output = step(str, fst, rstates);
+		std::map<char, int> byAccept;
+		for (size_t i = 0; i < subsets.size(); ++i)
+		{
+			auto inserted = byAccept.emplace(accept[i], static_cast<int>(byAccept.size()));
+			classes[i] = inserted.first->second;
+		}
+		classesCount = static_cast<int>(byAccept.size());
 	}
-	delete[] rstates;
 
-	return output ? (fst.rstates[fst.nstates - 1] == lstring) : output;
-}
\ No newline at end of file
+	for (;;)
+	{
+		std::map<std::vector<int>, int> bySignature;
+		std::vector<int> refined(subsets.size());
+		for (size_t i = 0; i < subsets.size(); ++i)
+		{
+			std::vector<int> signature;
+			signature.reserve(257);
+			signature.push_back(classes[i]);
+			for (int c = 0; c < 256; ++c)
+				signature.push_back(classes[transitions[i * 256 + c]]);
+
+			auto inserted = bySignature.emplace(std::move(signature), static_cast<int>(bySignature.size()));
+			refined[i] = inserted.first->second;
+		}
+
+		classes.swap(refined);
+		if (static_cast<int>(bySignature.size()) == classesCount)
+			break;
+		classesCount = static_cast<int>(bySignature.size());
+	}
+
+	//  :  - 0,   - 1,    
+	std::vector<short> renumber(classesCount, -1);
+	renumber[classes[0]] = deadState;
+	renumber[classes[1]] = startState;
+	short statesCount = 2;
+	for (size_t i = 0; i < subsets.size(); ++i)
+		if (renumber[classes[i]] < 0)
+			renumber[classes[i]] = statesCount++;
+
+	m_transitions.assign(statesCount * 256, deadState);
+	m_accept.assign(statesCount, EOF);
+	for (size_t i = 0; i < subsets.size(); ++i)
+	{
+		const short state = renumber[classes[i]];
+		m_accept[state] = accept[i];
+		for (int c = 0; c < 256; ++c)
+			m_transitions[state * 256 + c] = renumber[classes[transitions[i * 256 + c]]];
+	}
+}
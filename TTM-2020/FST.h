@@ -7,192 +7,7 @@
 
 #pragma region FST
 
-#pragma region I32
-
-#define FST_I32 FST::FST(4,\
-FST::NODE(1, FST::RELATION('i', 1)),\
-FST::NODE(1, FST::RELATION('3', 2)),\
-FST::NODE(1, FST::RELATION('2', 3)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region STR
-
-#define FST_STR FST::FST(4,\
-FST::NODE(1, FST::RELATION('s', 1)),\
-FST::NODE(1, FST::RELATION('t', 2)),\
-FST::NODE(1, FST::RELATION('r', 3)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region FN
-
-#define FST_FN FST::FST(3,\
-FST::NODE(1, FST::RELATION('f', 1)),\
-FST::NODE(1, FST::RELATION('n', 2)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region IF
-
-#define FST_IF FST::FST(3,\
-FST::NODE(1, FST::RELATION('i', 1)),\
-FST::NODE(1, FST::RELATION('f', 2)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region ELSE
-
-#define FST_ELSE FST::FST(5,\
-FST::NODE(1, FST::RELATION('e', 1)),\
-FST::NODE(1, FST::RELATION('l', 2)),\
-FST::NODE(1, FST::RELATION('s', 3)),\
-FST::NODE(1, FST::RELATION('e', 4)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region LET
-
-#define FST_LET FST::FST(4,\
-FST::NODE(1, FST::RELATION('l', 1)),\
-FST::NODE(1, FST::RELATION('e', 2)),\
-FST::NODE(1, FST::RELATION('t', 3)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region RET
-
-#define FST_RET FST::FST(4,\
-FST::NODE(1, FST::RELATION('r', 1)),\
-FST::NODE(1, FST::RELATION('e', 2)),\
-FST::NODE(1, FST::RELATION('t', 3)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region ECHO
-
-#define FST_ECHO FST::FST(5,\
-FST::NODE(1, FST::RELATION('e', 1)),\
-FST::NODE(1, FST::RELATION('c', 2)),\
-FST::NODE(1, FST::RELATION('h', 3)),\
-FST::NODE(1, FST::RELATION('o', 4)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region MAIN
-
-#define FST_MAIN FST::FST(5,\
-FST::NODE(1, FST::RELATION('m', 1)),\
-FST::NODE(1, FST::RELATION('a', 2)),\
-FST::NODE(1, FST::RELATION('i', 3)),\
-FST::NODE(1, FST::RELATION('n', 4)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region OPENING_PARENTHESIS
-
-#define FST_OPENING_PARENTHESIS FST::FST(2,\
-FST::NODE(1, FST::RELATION('(', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region CLOSING_PARENTHESIS
-
-#define FST_CLOSING_PARENTHESIS FST::FST(2,\
-FST::NODE(1, FST::RELATION(')', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region SEMICOLON
-
-#define FST_SEMICOLON FST::FST(2,\
-FST::NODE(1, FST::RELATION(';', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region COMMA
-
-#define FST_COMMA FST::FST(2,\
-FST::NODE(1, FST::RELATION(',', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region OPENING_CURLY_BRACE
-
-#define FST_OPENING_CURLY_BRACE FST::FST(2,\
-FST::NODE(1, FST::RELATION('{', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region CLOSING_CURLY_BRACE
-
-#define FST_CLOSING_CURLY_BRACE FST::FST(2,\
-FST::NODE(1, FST::RELATION('}', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region PLUS
-
-#define FST_PLUS FST::FST(2,\
-FST::NODE(1, FST::RELATION('+', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region MINUS
-
-#define FST_MINUS FST::FST(2,\
-FST::NODE(1, FST::RELATION('-', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region ASTERISK
-
-#define FST_ASTERISK FST::FST(2,\
-FST::NODE(1, FST::RELATION('*', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region SLASH
-
-#define FST_SLASH FST::FST(2,\
-FST::NODE(1, FST::RELATION('/', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region PERCENT
-
-#define FST_PERCENT FST::FST(2,\
-FST::NODE(1, FST::RELATION('%', 1)),\
-FST::NODE())
-
-#pragma endregion
-
-#pragma region ASSIGN
-
-#define FST_ASSIGN FST::FST(2,\
-FST::NODE(1, FST::RELATION('=', 1)),\
-FST::NODE())
-
-#pragma endregion
+//        keywords::spellings  FST(spelling)
 
 #pragma region IDENTIFIER
 
@@ -386,16 +201,49 @@ namespace FST
 		NODE(short n, RELATION rel, ...);
 	};
 
+	//     DFA:   ,      DFA
 	struct FST
 	{
-		short position;
 		short nstates;
 		NODE* nodes;
-		short* rstates;
 
 		FST(short ns, NODE n, ...);
+		//     spelling:     
+		explicit FST(std::string_view spelling);
 		~FST();
+
+		FST(const FST&) = delete;
+		FST& operator=(const FST&) = delete;
 	};
 
-	bool execute(std::string string, FST& fst);
+	//      FST:       
+	//  ,  -     256 ;    
+	//     FST,       (   FST_ID)
+	class DFA
+	{
+	public:
+		DFA(const FST* const* fsts, const char* lexemes, int count);
+
+		//     EOF
+		char execute(std::string_view string) const
+		{
+			short state = startState;
+			for (char c : string)
+			{
+				state = m_transitions[state * 256 + static_cast<unsigned char>(c)];
+				if (state == deadState)
+					return EOF;
+			}
+			return m_accept[state];
+		}
+
+		int statesCount() const { return static_cast<int>(m_accept.size()); }
+
+	private:
+		static constexpr short deadState = 0;
+		static constexpr short startState = 1;
+
+		std::vector<short> m_transitions;
+		std::vector<char> m_accept;
+	};
 };
\ No newline at end of file
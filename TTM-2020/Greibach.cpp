@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "Greibach.h"
+#include "Arena.h"
 #define GRB_ERROR_SERIES 600
 
 namespace GRB {
@@ -10,7 +11,8 @@ namespace GRB {
 	Rule::Chain::Chain(short size, GRBALPHABET s, ...)
 		: size(size)
 	{
-		nt = DBG_NEW GRBALPHABET[size];
+		// ,     ,      
+		nt = TTM::allocateArray<GRBALPHABET>(size);
 		int* p = (int*)&s;
 
 		for (short i = 0; i < size; ++i) {
@@ -25,7 +27,7 @@ namespace GRB {
 	Rule::Rule(GRBALPHABET nn, int iderror, short size, Chain c, ...)
 		: nn(nn), iderror(iderror), size(size)
 	{
-		chains = DBG_NEW Chain[size];
+		chains = TTM::allocateArray<Chain>(size);
 		Chain* p = &c;
 		for (int i = 0; i < size; ++i) {
 			chains[i] = p[i];
@@ -39,7 +41,7 @@ namespace GRB {
 	Greibach::Greibach(GRBALPHABET startN, GRBALPHABET stbottomT, short size, Rule r, ...)
 		: startN(startN), stbottomT(stbottomT), size(size)
 	{
-		rules = DBG_NEW Rule[size];
+		rules = TTM::allocateArray<Rule>(size);
 		const Rule* p = &r;
 		for (int i = 0; i < size; ++i) {
 			rules[i] = p[i];
@@ -101,6 +103,37 @@ namespace GRB {
 		return rules[n];
 	}
 
+	ChainIndex::ChainIndex(const Greibach& greibach) {
+		std::fill(std::begin(m_rules), std::end(m_rules), -1);
+		for (short r = greibach.size - 1; r >= 0; --r) {
+			m_rules[static_cast<unsigned char>(Rule::Chain::alphabet_to_char(greibach.rules[r].nn))] = r;
+		}
+
+		m_offsets.reserve(greibach.size * 256 + 1);
+		for (short r = 0; r < greibach.size; ++r) {
+			const Rule& rule = greibach.rules[r];
+			for (int t = 0; t < 256; ++t) {
+				m_offsets.push_back(m_chains.size());
+				for (short c = 0; c < rule.size; ++c) {
+					//    - Chain::T(char),     getNextChain
+					if (rule.chains[c].nt == nullptr || rule.chains[c].nt[0] == Rule::Chain::T(static_cast<char>(t))) {
+						m_chains.push_back(c);
+					}
+				}
+			}
+		}
+		m_offsets.push_back(m_chains.size());
+	}
+
+	short ChainIndex::nextChain(short nrule, GRBALPHABET t, short after) const {
+		const int cell = nrule * 256 + static_cast<unsigned char>(t);
+		const short* first = m_chains.data() + m_offsets[cell];
+		const short* last = m_chains.data() + m_offsets[cell + 1];
+		const short* found = std::upper_bound(first, last, after);
+
+		return (found != last) ? *found : -1;
+	}
+
 	const Greibach getGreibach() {
 #pragma region Rules
 		const Greibach greibach(NS('S'), TS('$'),
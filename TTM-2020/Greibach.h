@@ -47,4 +47,23 @@ namespace GRB {
 		Rule getRule(short n) const;
 	};
 	const Greibach getGreibach();
+
+	//   ,  getNextChain     ,    :
+	// ,   ,   .     
+	class ChainIndex
+	{
+	public:
+		explicit ChainIndex(const Greibach& greibach);
+
+		//     -1
+		short rule(GRBALPHABET nn) const { return Rule::Chain::isN(nn) ? m_rules[static_cast<unsigned char>(Rule::Chain::alphabet_to_char(nn))] : -1; }
+		//     nrule    after  -1
+		short nextChain(short nrule, GRBALPHABET t, short after) const;
+
+	private:
+		short m_rules[256];
+		//   (, )   m_chains  m_offsets[nrule * 256 + ]   
+		std::pmr::vector<int> m_offsets;
+		std::pmr::vector<short> m_chains;
+	};
 }
\ No newline at end of file
@@ -2,96 +2,197 @@
 #include "IdTable.h"
 #include "Error.h"
 
-TTM::IdTable::Entry::Entry(std::string name, std::string scope, int lexTableIndex, it::id_type idType, int value)
-	: name(name), scope(scope), lexTableIndex(lexTableIndex), dataType(it::data_type::i32), idType(idType)
+TTM::IdTable::Entry::Entry(symbol name, symbol scope, int lexTableIndex, it::data_type dataType, it::id_type idType, int value)
+	: name(name), scope(scope), lexTableIndex(lexTableIndex), dataType(dataType), idType(idType)
 {
+	this->value.strValue = { 0, 0 };
 	this->value.intValue = value;
 }
 
-TTM::IdTable::Entry::Entry(std::string name, std::string scope, int lexTableIndex, it::id_type idType, const char* value)
-	: name(name), scope(scope), lexTableIndex(lexTableIndex), dataType(it::data_type::str), idType(idType)
-
+int TTM::IdTable::addEntry(const Entry& entry)
 {
-	setValue(value);
-}
+	if (entry.idType == it::id_type::unknown)
+		throw ERROR_THROW(120);
+	if (entry.dataType == it::data_type::undefined)
+		throw ERROR_THROW(121);
 
-TTM::IdTable::Entry::Entry(std::string name, std::string scope, int lexTableIndex, it::data_type dataType, it::id_type idType, const char* value)
-	: name(name), scope(scope), lexTableIndex(lexTableIndex), dataType(dataType), idType(idType)
+	m_table.push_back(entry);
+	const int index = m_table.size() - 1;
+
+	m_scopes[entry.scope].emplace(entry.name, index);
+	if (entry.idType == it::id_type::literal)
+	{
+		if (entry.dataType == it::data_type::i32)
+			m_intLiterals.emplace(entry.value.intValue, index);
+		else
+			m_stringLiterals.emplace(stringValue(index), index);
+	}
 
+	return index;
+}
+
+int TTM::IdTable::addEntry(Entry entry, std::string_view value)
 {
-	if (dataType == it::data_type::i32)
-		this->value.intValue = atoi(value);
-	else
-		setValue(value);
+	entry.value.strValue = { static_cast<int>(m_strings.size()), static_cast<int>(value.size()) };
+	m_strings.append(value);
+	return addEntry(entry);
 }
 
-void TTM::IdTable::Entry::setValue(int new_value)
+void TTM::IdTable::assign(const Entry* entries, size_t count, std::string_view strings)
 {
-	if (dataType == it::data_type::i32)
-		value.intValue = new_value;
+	truncate(0);
+	m_strings.assign(strings);
+	m_table.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+		addEntry(entries[i]);
 }
 
-void TTM::IdTable::Entry::setValue(const char* new_value)
+void TTM::IdTable::truncate(int size)
 {
-	if (dataType == it::data_type::str)
+	size_t stringsSize = m_strings.size();
+	for (size_t i = size; i < m_table.size(); ++i)
 	{
-		value.strValue.length = static_cast<char>(strlen(new_value)) - 2;
-		strcpy_s(value.strValue.string, new_value);
+		unindex(i);
+		//     ,      
+		const Entry& e = m_table[i];
+		if (e.idType == it::id_type::literal && e.dataType == it::data_type::str)
+			stringsSize = std::min(stringsSize, static_cast<size_t>(e.value.strValue.offset));
 	}
+	m_strings.resize(stringsSize);
+
+	m_table.resize(std::min(static_cast<size_t>(size), m_table.size()));
 }
 
-int TTM::IdTable::addEntry(const Entry& entry)
+void TTM::IdTable::unindex(size_t index)
 {
-	if (entry.idType == it::id_type::unknown)
-		throw ERROR_THROW(120);
-	if (entry.dataType == it::data_type::undefined)
-		throw ERROR_THROW(121);
+	const Entry& e = m_table[index];
+	// find,   operator[]:        
+	auto scope = m_scopes.find(e.scope);
+	if (scope != m_scopes.end())
+	{
+		auto& names = scope->second;
+		auto name = names.find(e.name);
+		if (name != names.end() && name->second == static_cast<int>(index))
+			names.erase(name);
+	}
 
-	m_table.push_back(entry);
-	return m_table.size() - 1;
+	if (e.idType != it::id_type::literal)
+		return;
+
+	if (e.dataType == it::data_type::i32)
+	{
+		auto found = m_intLiterals.find(e.value.intValue);
+		if (found != m_intLiterals.end() && found->second == static_cast<int>(index))
+			m_intLiterals.erase(found);
+	}
+	else
+	{
+		auto found = m_stringLiterals.find(literalKey(stringValue(index)));
+		if (found != m_stringLiterals.end() && found->second == static_cast<int>(index))
+			m_stringLiterals.erase(found);
+	}
 }
 
-int TTM::IdTable::getIdIndexByName(std::string scope, std::string name)
+const std::pmr::vector<int>& TTM::IdTable::reorder(const std::pmr::vector<int>& removed, const std::pmr::vector<symbol>& literalNames)
 {
-	for (size_t i = 0; i < m_table.size(); ++i)
+	for (int index : removed)
+		unindex(index);
+
+	m_order.clear();
+	for (int i = 0; i < size(); ++i)
+	{
+		if (!std::binary_search(removed.begin(), removed.end(), i))
+			m_order.push_back(i);
+	}
+	//     lexTableIndex == TI_NULLIDX,       
+	std::stable_sort(m_order.begin(), m_order.end(),
+		[this](int a, int b) { return m_table[a].lexTableIndex < m_table[b].lexTableIndex; });
+
+	//      ,    truncate
+	m_remap.assign(m_table.size(), TI_NULLIDX);
+	m_reordered.clear();
+	m_reorderedStrings.clear();
+	for (int index : m_order)
 	{
-		if (m_table[i].scope == scope && m_table[i].name == name)
+		Entry e = m_table[index];
+		if (e.idType == it::id_type::literal && e.dataType == it::data_type::str)
 		{
-			return i;
+			e.value.strValue.offset = static_cast<int>(m_reorderedStrings.size());
+			m_reorderedStrings.append(stringValue(index));
 		}
+		m_remap[index] = static_cast<int>(m_reordered.size());
+		m_reordered.push_back(e);
 	}
+	m_table.assign(m_reordered.begin(), m_reordered.end());
+	m_strings.assign(m_reorderedStrings);
 
-	return TI_NULLIDX;
-}
-
-int TTM::IdTable::getLiteralIndexByValue(int value) {
-	for (size_t i = 0; i < m_table.size(); ++i)
+	//    :        ,    
+	for (auto& [scope, names] : m_scopes)
 	{
-		if (m_table[i].idType == it::id_type::literal && m_table[i].value.intValue == value)
-		{
-			return i;
-		}
+		for (auto& [name, index] : names)
+			index = m_remap[index];
 	}
+	for (auto& [value, index] : m_intLiterals)
+		index = m_remap[index];
+	for (auto& [value, index] : m_stringLiterals)
+		index = m_remap[index];
+
+	auto& globals = m_scopes[Interner::empty];
+	size_t literals = 0;
+	for (int i = 0; i < size(); ++i)
+	{
+		if (m_table[i].idType != it::id_type::literal)
+			continue;
+		m_table[i].name = literalNames[literals];
+		globals[literalNames[literals]] = i;
+		++literals;
+	}
+	for (size_t n = literals; n < literalNames.size(); ++n)
+		globals.erase(literalNames[n]);
 
-	return TI_NULLIDX;
+	return m_remap;
 }
 
-int TTM::IdTable::getLiteralIndexByValue(const char* value) {
-	for (size_t i = 0; i < m_table.size(); ++i)
+void TTM::IdTable::shiftLexTableIndices(int from, int delta)
+{
+	if (delta == 0)
+		return;
+
+	for (Entry& e : m_table)
 	{
-		if (m_table[i].idType == it::id_type::literal && !strcmp(m_table[i].value.strValue.string, value))
-		{
-			return i;
-		}
+		if (e.lexTableIndex >= from)
+			e.lexTableIndex += delta;
 	}
+}
+
+int TTM::IdTable::getIdIndexByName(symbol scope, symbol name)
+{
+	auto names = m_scopes.find(scope);
+	if (names == m_scopes.end())
+		return TI_NULLIDX;
+
+	auto found = names->second.find(name);
+	return found != names->second.end() ? found->second : TI_NULLIDX;
+}
 
-	return TI_NULLIDX;
+int TTM::IdTable::getLiteralIndexByValue(int value) {
+	auto found = m_intLiterals.find(value);
+	return found != m_intLiterals.end() ? found->second : TI_NULLIDX;
 }
 
-const std::string TTM::IdTable::dumpTable(size_t startIndex, size_t endIndex) const
+int TTM::IdTable::getLiteralIndexByValue(std::string_view value) {
+	auto found = m_stringLiterals.find(literalKey(value));
+	return found != m_stringLiterals.end() ? found->second : TI_NULLIDX;
+}
+
+const std::pmr::string& TTM::IdTable::literalKey(std::string_view value)
 {
-	std::stringstream output;
+	m_literalKey.assign(value);
+	return m_literalKey;
+}
 
+void TTM::IdTable::dumpTable(BufferedWriter& output, dump::format format, size_t startIndex, size_t endIndex) const
+{
 	startIndex = std::clamp(startIndex, 0U, m_table.size());
 	if (endIndex == 0)
 	{
@@ -102,30 +203,52 @@ const std::string TTM::IdTable::dumpTable(size_t startIndex, size_t endIndex) co
 		endIndex = std::clamp(endIndex, startIndex, m_table.size());
 	}
 
-	output << std::setw(5) << "index " << std::setw(15) << "name " << std::setw(15) << "scope "
-		<< std::setw(8) << "type " << std::setw(15) << "value " << std::setw(20) << "id type " << std::setw(20) << "lexTable index " << '\n';
+	auto idTypeName = [](it::id_type idType) -> std::string_view
+	{
+		switch (idType)
+		{
+		case it::id_type::function:		return "function";
+		case it::id_type::literal:		return "literal";
+		case it::id_type::parameter:	return "parameter";
+		case it::id_type::variable:		return "variable";
+		default:						return "";
+		}
+	};
+
+	if (format == dump::format::tsv)
+	{
+		output << "index\tname\tscope\ttype\tvalue\tid type\tlexTable index\n";
+		for (size_t i = startIndex; i < endIndex; ++i)
+		{
+			output << i << '\t' << name(i) << '\t' << scope(i) << '\t';
+			if (m_table[i].dataType == it::data_type::i32)
+				output << "i32\t" << m_table[i].value.intValue;
+			else if (m_table[i].dataType == it::data_type::str && m_table[i].idType == it::id_type::literal)
+				output << "str\t" << stringValue(i);
+			else if (m_table[i].dataType == it::data_type::str)
+				output << "str\t" << m_table[i].value.intValue;
+			else
+				output << '\t';
+			output << '\t' << idTypeName(m_table[i].idType) << '\t' << m_table[i].lexTableIndex << '\n';
+		}
+		return;
+	}
+
+	output.right("index ", 5).right("name ", 15).right("scope ", 15)
+		.right("type ", 8).right("value ", 15).right("id type ", 20).right("lexTable index ", 20) << '\n';
 	for (size_t i = startIndex; i < endIndex; ++i)
 	{
-		output << std::setw(5) << i << std::setw(15) << m_table[i].name << std::setw(15) << m_table[i].scope
-			<< std::setw(8);
+		output.right(i, 5).right(name(i), 15).right(scope(i), 15);
 		if (m_table[i].dataType == it::data_type::i32)
-			output << "i32 " << std::setw(15) << m_table[i].value.intValue;
+			output.right("i32 ", 8).right(m_table[i].value.intValue, 15);
+		else if (m_table[i].dataType == it::data_type::str && m_table[i].idType == it::id_type::literal)
+			output.right("str ", 8).right(stringValue(i), 15);
 		else if (m_table[i].dataType == it::data_type::str)
-			output << "str " << std::setw(15) << m_table[i].value.strValue.string;
-
-		output << std::setw(20);
-		if (m_table[i].idType == it::id_type::function)
-			output << "function";
-		else if (m_table[i].idType == it::id_type::literal)
-			output << "literal";
-		else if (m_table[i].idType == it::id_type::parameter)
-			output << "parameter";
-		else if (m_table[i].idType == it::id_type::variable)
-			output << "variable";
-
-		output << std::setw(20) << m_table[i].lexTableIndex;
+			output.right("str ", 8).right(m_table[i].value.intValue, 15);
+
+		if (m_table[i].idType != it::id_type::unknown)
+			output.right(idTypeName(m_table[i].idType), 20);
+		output.right(m_table[i].lexTableIndex, 20);
 		output << '\n';
 	}
-
-	return output.str();
-}
\ No newline at end of file
+}
@@ -5,54 +5,83 @@
 #define TI_INT_DEFAULT	0x00000000
 #define TI_STR_DEFAULT	0x00
 #define TI_NULLIDX		((int)0xffffffff)
-#define TI_STR_MAXSIZE	255
+
+#include "Interner.h"
+#include "BufferedWriter.h"
 
 namespace TTM
 {
 	namespace it
 	{
-		enum class data_type { i32, str, undefined };
-		enum class id_type { variable, function, parameter, literal, unknown };
+		enum class data_type : char { i32, str, undefined };
+		enum class id_type : char { variable, function, parameter, literal, unknown };
 	}
 
 	class IdTable
 	{
 	public:
+		using symbol = Interner::symbol;
+
+		//   :        ,    
 		struct Entry
 		{
-			std::string name;
-			std::string scope;
+			//       symbols() 
+			symbol name;
+			symbol scope;
 			int lexTableIndex;
 			it::data_type dataType;
 			it::id_type idType;
 			union
 			{
 				int intValue;
+				//      stringValue()
 				struct
 				{
-					char length;
-					char string[TI_STR_MAXSIZE - 1];
+					int offset;
+					int length;
 				} strValue;
 			} value;
 
-			void setValue(int new_value);
-			void setValue(const char* new_value);
-
 			Entry() = default;
-			Entry(std::string name, std::string scope, int lexTableIndex, it::id_type idType, int value);
-			Entry(std::string name, std::string scope, int lexTableIndex, it::id_type idType, const char* value);
-			Entry(std::string name, std::string scope, int lexTableIndex, it::data_type dataType, it::id_type idType, const char* value);
+			Entry(symbol name, symbol scope, int lexTableIndex, it::data_type dataType, it::id_type idType, int value = TI_INT_DEFAULT);
 		};
 
-		int getIdIndexByName(std::string scope, std::string name);
+		int getIdIndexByName(symbol scope, symbol name);
 		int getLiteralIndexByValue(int value);
-		int getLiteralIndexByValue(const char* value);
+		int getLiteralIndexByValue(std::string_view value);
 
 		int addEntry(const Entry& entry);
+		//  :  value    ,   
+		int addEntry(Entry entry, std::string_view value);
+		std::string_view stringValue(size_t index) const
+		{
+			return std::string_view(m_strings).substr(m_table[index].value.strValue.offset, m_table[index].value.strValue.length);
+		}
+		//  ,   ,     size
+		void truncate(int size);
+		//         from     
+		void shiftLexTableIndices(int from, int delta);
+		//    lexTableIndex,     ,  removed ( )
+		// ,      literalNames;  -    
+		//   TI_NULLIDX  
+		const std::pmr::vector<int>& reorder(const std::pmr::vector<int>& removed, const std::pmr::vector<symbol>& literalNames);
 
 		int size() const { return m_table.size(); }
 
-		const std::string dumpTable(size_t startIndex = 0, size_t endIndex = 0) const;
+		//     ;        truncate
+		symbol intern(std::string_view str) { return m_symbols.intern(str); }
+		const Interner& symbols() const { return m_symbols; }
+		std::string_view name(size_t index) const { return m_symbols.str(m_table[index].name); }
+		std::string_view scope(size_t index) const { return m_symbols.str(m_table[index].scope); }
+
+		//  [startIndex, endIndex)   output; endIndex == 0 -   
+		void dumpTable(BufferedWriter& output, dump::format format = dump::format::text, size_t startIndex = 0, size_t endIndex = 0) const;
+
+		//     ,   
+		const Entry* entries() const { return m_table.data(); }
+		std::string_view strings() const { return m_strings; }
+		//      ;    entries     intern
+		void assign(const Entry* entries, size_t count, std::string_view strings);
 
 		Entry& operator[](size_t index)
 		{
@@ -65,6 +94,28 @@ namespace TTM
 		}
 
 	private:
-		std::vector<Entry> m_table;
+		std::pmr::vector<Entry> m_table;
+		Interner m_symbols;
+		//    ,   (  truncate)
+		std::pmr::string m_strings;
+		//    :   ->   ->   ;
+		//  Interner::empty - ,   
+		std::pmr::unordered_map<symbol, std::pmr::unordered_map<symbol, int>> m_scopes;
+		//     ,   addEntry  truncate
+		std::pmr::unordered_map<int, int> m_intLiterals;
+		std::pmr::unordered_map<std::pmr::string, int> m_stringLiterals;
+		//    m_stringLiterals ,       
+		std::pmr::string m_literalKey;
+		//  reorder:      
+		std::pmr::vector<int> m_remap;
+		std::pmr::vector<int> m_order;
+		std::pmr::vector<Entry> m_reordered;
+		std::pmr::string m_reorderedStrings;
+
+		const std::pmr::string& literalKey(std::string_view value);
+		//  index       
+		void unindex(size_t index);
 	};
+
+	static_assert(sizeof(IdTable::Entry) <= 24, "IdTable::Entry should stay a small record");
 }
\ No newline at end of file
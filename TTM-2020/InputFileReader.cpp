@@ -2,135 +2,251 @@
 #include "InputFileReader.h"
 #include "Error.h"
 #include "IdTable.h"
+#include "CharScanner.h"
+#include "Parallel.h"
 
 TTM::InputFileReader::InputFileReader()
-	: m_fileSize(0), m_linesCount(1), m_ignoredCharsCount(0), m_fileText(""), m_codeTable{ IN_CODE_TABLE }
+	: m_codeTable{ IN_CODE_TABLE }, m_fileSize(0), m_linesCount(1), m_ignoredCharsCount(0), m_encoding(in::encoding::cp1251)
 {	}
 
-void TTM::InputFileReader::read(const char* inFilePath)
+void TTM::InputFileReader::read(const char* inFilePath, in::encoding encoding)
 {
-	std::ifstream inputFile(inFilePath, std::ios::ate);
-
-	if (!inputFile.is_open())
+	if (!m_source.open(inFilePath))
 		throw ERROR_THROW(110);
 
-	m_fileText.reserve((size_t)inputFile.tellg());
-	inputFile.seekg(std::ios::beg);
+	std::string_view text{ m_source.data(), m_source.size() };
+	if (encoding == in::encoding::utf8 && text.substr(0, 3) == "\xEF\xBB\xBF")
+		text.remove_prefix(3);
+
+	readText(text, encoding);
+}
 
-	for (int readChar = 0, column = 0; (readChar = inputFile.get()) != EOF; ++m_fileSize)
+void TTM::InputFileReader::readText(std::string_view text, in::encoding encoding, int firstLine)
+{
+	m_encoding = encoding;
+	m_text = text;
+	const char* const data = m_text.data();
+	const char* const end = data + m_text.size();
+	const scan::Scanner& scanner = scan::scanner();
+
+	//  UTF-8   0x80     ,      
+	if (m_encoding == in::encoding::utf8)
+		validateUtf8(data, end, firstLine);
+
+	//      :    ,    
+	const size_t chunksCount = parallel::workersCount(end - data, minChunkSize);
+	std::vector<Chunk> chunks;
+	for (size_t i = 1; i <= chunksCount && (chunks.empty() || chunks.back().end != end); ++i)
 	{
-		++column;
-		if (readChar == in::endl)
+		const char* begin = chunks.empty() ? data : chunks.back().end;
+		const char* chunkEnd = end;
+		if (i != chunksCount)
 		{
-			++m_linesCount;
-			column = 0;
-			writeDelimiter();
-			m_fileText.push_back(in::endl);
+			chunkEnd = scanner.findNewline(std::max(begin, data + (end - data) / chunksCount * i), end);
+			if (chunkEnd != end)
+				++chunkEnd;
 		}
-		else if (readChar == in::comment)
+		chunks.emplace_back(begin, chunkEnd);
+	}
+
+	parallel::forEach(chunks.size(), [&](size_t i) { readChunk(chunks[i], end); });
+
+	//       ,      
+	for (size_t i = 0; i + 1 < chunks.size() && !chunks[i].failed; ++i)
+	{
+		if (chunks[i].stoppedAt != chunks[i].end)
 		{
-			if (inputFile.peek() == in::comment)
+			chunks.clear();
+			chunks.emplace_back(data, end);
+			readChunk(chunks.front(), end);
+			break;
+		}
+	}
+
+	merge(chunks, firstLine);
+}
+
+void TTM::InputFileReader::validateUtf8(const char* begin, const char* end, int firstLine) const
+{
+	if (scan::scanner().validateUtf8(begin, end))
+		return;
+
+	//          
+	const char* invalid = scan::findInvalidUtf8(begin, end);
+	int line = firstLine;
+	const char* lineBegin = begin;
+	for (const char* newline = begin; (newline = scan::scanner().findNewline(newline, invalid)) != invalid; lineBegin = ++newline)
+		++line;
+
+	throw ERROR_THROW_IN(113, line, static_cast<int>(invalid - lineBegin) + 1);
+}
+
+void TTM::InputFileReader::readChunk(Chunk& chunk, const char* fileEnd) const
+{
+	const char* const data = m_text.data();
+	const char* position = chunk.begin;
+	const char* const end = fileEnd;
+
+	// get()  peek()   ifstream   : "\r\n"   '\n'
+	auto peek = [&]() -> int
+	{
+		if (position == end)
+			return EOF;
+		if (*position == '\r' && position + 1 != end && position[1] == in::endl)
+			return in::endl;
+		return static_cast<unsigned char>(*position);
+	};
+	auto get = [&]() -> int
+	{
+		int readChar = peek();
+		if (readChar != EOF)
+			position += (*position == '\r' && readChar == in::endl) ? 2 : 1;
+		return readChar;
+	};
+
+	const scan::Scanner& scanner = scan::scanner();
+	int line = 1;
+
+	auto addToken = [&](const char* tokenBegin, const char* tokenEnd)
+	{
+		chunk.tokens.push_back({ static_cast<unsigned>(tokenBegin - data), static_cast<unsigned>(tokenEnd - tokenBegin), line });
+	};
+
+	try
+	{
+		for (int column = 0; position < chunk.end; ++chunk.fileSize)
+		{
+			const char* current = position;
+			int readChar = get();
+
+			++column;
+			if (readChar == in::endl)
+			{
+				++chunk.linesCount;
+				++line;
+				column = 0;
+				continue;
+			}
+			else if (readChar == in::comment && peek() == in::comment)
 			{
-				do
+				//       , "\r\n"   
+				const char* newline = scanner.findNewline(position, end);
+				chunk.ignoredCharsCount += static_cast<int>(newline - position);
+				if (newline != end)
 				{
-					readChar = inputFile.get();
-					++m_ignoredCharsCount;
-				} while (readChar != in::endl);
-				m_fileText.push_back(in::endl);
+					if (newline[-1] == '\r')
+						--chunk.ignoredCharsCount;
+					++chunk.ignoredCharsCount;
+					++newline;
+				}
+				position = newline;
+
+				++line;
+				column = 0;
+				continue;
 			}
-		}
 
-		switch (m_codeTable[readChar])
-		{
-		case in::T:
-			if (!m_fileText.empty() && m_fileText.back() != in::delimiter && m_codeTable[m_fileText.back()] != in::T)
+			switch (m_codeTable[readChar])
+			{
+			case in::T:
 			{
-				m_fileText.push_back(in::delimiter);
+				const char* tokenEnd = scanner.findNonIdentifier(position, end);
+				column += static_cast<int>(tokenEnd - position);
+				chunk.fileSize += tokenEnd - position;
+				position = tokenEnd;
+				addToken(current, tokenEnd);
+				break;
 			}
-			m_fileText.push_back(readChar);
-			break;
 
-		case in::F:
-			throw ERROR_THROW_IN(111, m_linesCount, column);
-			break;
+			case in::F:
+				throw ERROR_THROW_IN(111, line, column);
+				break;
 
-		case in::I:
-			++m_ignoredCharsCount;
-			break;
+			case in::I:
+				++chunk.ignoredCharsCount;
+				break;
 
-		case in::O:
-			writeDelimiter();
-			m_fileText.push_back(readChar);
-			break;
+			case in::O:
+			case in::S:
+				addToken(current, position);
+				break;
 
-		case in::Q:
-			writeDelimiter();
-			do
+			case in::Q:
 			{
-				m_fileText.push_back(readChar);
-				readChar = inputFile.get();
-				++m_fileSize;
-				++column;
-			} while (m_codeTable[readChar] != in::Q && column <= TI_STR_MAXSIZE);
-			m_fileText.push_back(readChar);
-			break;
+				++chunk.quotesCount;
 
-		case in::S:
-			writeDelimiter();
-			m_fileText.push_back(readChar);
-			m_fileText.push_back(in::delimiter);
-			break;
+				//        ;    
+				//        .       
+				const char* window = end;
+				const char* quote = scanner.findQuote(position, window);
+				const char* stringEnd = (quote != window) ? quote + 1 : window;
 
-		default:
-			if (!m_fileText.empty() && m_fileText.back() != in::delimiter)
-			{
-				m_fileText.push_back(m_codeTable[readChar]);
+				if (scanner.findNewline(position, stringEnd) == stringEnd)
+				{
+					column += static_cast<int>(stringEnd - position);
+					chunk.fileSize += stringEnd - position;
+					position = stringEnd;
+					if (quote != window)
+						++chunk.quotesCount;
+				}
+				else
+				{
+					do
+					{
+						readChar = get();
+						++chunk.fileSize;
+						++column;
+					} while (readChar != EOF && m_codeTable[readChar] != in::Q);
+
+					if (readChar != EOF && m_codeTable[readChar] == in::Q)
+						++chunk.quotesCount;
+				}
+				addToken(current, position);
+				break;
+			}
+
+			default:
+				break;
 			}
-			break;
 		}
 	}
-
-	if (std::count(m_fileText.begin(), m_fileText.end(), '\'') % 2 != 0)
-		throw ERROR_THROW(132);
-
-	inputFile.close();
-}
-
-void TTM::InputFileReader::writeDelimiter()
-{
-	if (!m_fileText.empty() && m_fileText.back() != in::delimiter)
+	catch (Error::ERROR& e)
 	{
-		m_fileText.push_back(in::delimiter);
+		chunk.failed = true;
+		chunk.error = e;
 	}
+
+	chunk.stoppedAt = position;
+	chunk.lines = line - 1;
 }
 
-std::vector<std::pair<std::string, int>> TTM::InputFileReader::splitStringByDelimiter(std::string s, char delimiter)
+void TTM::InputFileReader::merge(std::vector<Chunk>& chunks, int firstLine)
 {
-	std::vector<std::pair<std::string, int>> output;
-	output.reserve(std::count_if(s.begin(), s.end(), [&](char c) { return c == delimiter; }) + 1);
-
-	int lineNumber = 1;
-	size_t start = 0;
-	size_t end = s.find(delimiter);
+	int line = firstLine;
+	int quotesCount = 0;
 
-	while (end != std::string::npos)
+	for (Chunk& chunk : chunks)
 	{
-		std::string substr = s.substr(start, end - start);
-		if (substr.find(in::endl) != std::string::npos)
+		if (chunk.failed)
 		{
-			++lineNumber;
+			chunk.error.inext.line += line - 1;
+			throw chunk.error;
 		}
+
+		for (in::TokenSpan& token : chunk.tokens)
+			token.line += line - 1;
+		if (m_tokens.empty())
+			m_tokens = std::move(chunk.tokens);
 		else
-		{
-			output.push_back({ substr, lineNumber });
-		}
-		start = end + 1;
-		end = s.find(delimiter, start);
-	}
+			m_tokens.insert(m_tokens.end(), chunk.tokens.begin(), chunk.tokens.end());
 
-	std::string last_element = s.substr(start, end);
-	if (!last_element.empty() && last_element.find(delimiter) == std::string::npos)
-		output.push_back({ last_element, lineNumber });
+		m_fileSize += chunk.fileSize;
+		m_linesCount += chunk.linesCount;
+		m_ignoredCharsCount += chunk.ignoredCharsCount;
+		quotesCount += chunk.quotesCount;
+		line += chunk.lines;
+	}
 
-	return output;
-}
\ No newline at end of file
+	if (quotesCount % 2 != 0)
+		throw ERROR_THROW(132);
+}
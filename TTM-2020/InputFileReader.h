@@ -1,4 +1,6 @@
 #pragma once
+#include "MappedFile.h"
+#include "Error.h"
 
 namespace TTM
 {
@@ -6,6 +8,9 @@ namespace TTM
 	{
 		enum { endl = '\n', comment = '/', delimiter = '|' };
 
+		//   :  cp1251  UTF-8     BOM
+		enum class encoding { cp1251, utf8 };
+
 		// T -  , F - , I - , O - , Q - ', S - 
 		enum { T = 1024, F = 2048, I = 4096, O = 8192, Q = 16384, S = 32768 };
 
@@ -27,6 +32,14 @@ namespace TTM
 			in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, \
 			in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, \
 			in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F, in::F
+
+		//     : ,    
+		struct TokenSpan
+		{
+			unsigned offset;
+			unsigned length;
+			int line;
+		};
 	}
 
 	class InputFileReader
@@ -35,21 +48,51 @@ namespace TTM
 		size_t fileSize() const { return m_fileSize; }
 		int linesCount() const { return m_linesCount; }
 		int ignoredCharsCount() const { return m_ignoredCharsCount; }
+		in::encoding encoding() const { return m_encoding; }
 
-		const std::string& fileText() const { return m_fileText; }
+		std::string_view source() const { return m_text; }
+		const std::vector<in::TokenSpan>& tokens() const { return m_tokens; }
 
 		int m_codeTable[256];
 
 		InputFileReader();
-		void read(const char* inFilePath);
+		void read(const char* inFilePath, in::encoding encoding = in::encoding::cp1251);
+		//    ,   ;     firstLine
+		void readText(std::string_view text, in::encoding encoding = in::encoding::cp1251, int firstLine = 1);
 
-		static std::vector<std::pair<std::string, int>> splitStringByDelimiter(std::string s, char delimiter);
 	private:
+		//  ,   ;     ,
+		//          
+		struct Chunk
+		{
+			const char* begin;
+			const char* end;
+			const char* stoppedAt = nullptr;
+			std::vector<in::TokenSpan> tokens;
+			size_t fileSize = 0;
+			int linesCount = 0;
+			int ignoredCharsCount = 0;
+			int lines = 0;
+			int quotesCount = 0;
+			bool failed = false;
+			Error::ERROR error;
+
+			Chunk(const char* begin, const char* end) : begin(begin), end(end) {}
+		};
+
+		//   ,      
+		static constexpr size_t minChunkSize = 1 << 20;
+
+		void validateUtf8(const char* begin, const char* end, int firstLine) const;
+		void readChunk(Chunk& chunk, const char* fileEnd) const;
+		void merge(std::vector<Chunk>& chunks, int firstLine);
+
 		size_t m_fileSize;
 		int m_linesCount;
 		int m_ignoredCharsCount;
-		std::string m_fileText;
-
-		void writeDelimiter();
+		in::encoding m_encoding;
+		std::vector<in::TokenSpan> m_tokens;
+		MappedFile m_source;
+		std::string_view m_text;
 	};
 }
\ No newline at end of file
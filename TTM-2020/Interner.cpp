@@ -0,0 +1,25 @@
+#include "pch.h"
+#include "Interner.h"
+
+TTM::Interner::Interner()
+{
+	intern("");
+}
+
+TTM::Interner::symbol TTM::Interner::intern(std::string_view str)
+{
+	auto found = m_symbols.find(str);
+	if (found != m_symbols.end())
+		return found->second;
+
+	const symbol s = static_cast<symbol>(m_strings.size());
+	m_strings.emplace_back(str);
+	m_symbols.emplace(m_strings.back(), s);
+	return s;
+}
+
+TTM::Interner::symbol TTM::Interner::find(std::string_view str) const
+{
+	auto found = m_symbols.find(str);
+	return found != m_symbols.end() ? found->second : none;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace TTM
+{
+	//      (   ):   
+	//   ,    ;  0 -  ,    
+	class Interner
+	{
+	public:
+		using symbol = int;
+		static constexpr symbol empty = 0;
+		static constexpr symbol none = -1;
+
+		Interner();
+		Interner(const Interner&) = delete;
+		Interner& operator=(const Interner&) = delete;
+		Interner(Interner&&) = default;
+		Interner& operator=(Interner&&) = default;
+
+		//  ,     
+		symbol intern(std::string_view str);
+		//    none,    
+		symbol find(std::string_view str) const;
+
+		std::string_view str(symbol s) const { return m_strings[s]; }
+		int size() const { return static_cast<int>(m_strings.size()); }
+
+	private:
+		// deque     ,  -  
+		std::pmr::deque<std::pmr::string> m_strings;
+		std::pmr::unordered_map<std::string_view, symbol> m_symbols;
+	};
+}
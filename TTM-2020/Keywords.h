@@ -0,0 +1,103 @@
+#pragma once
+#include "LexTable.h"
+
+namespace TTM
+{
+	namespace keywords
+	{
+		struct Spelling
+		{
+			const char* text;
+			size_t length;
+			char lexeme;
+		};
+
+		//     -   :      find,  
+		//  LexicalAnalyzer::tokenFsts,  find     
+		constexpr Spelling spellings[] = {
+			{ "i32", 3, LEX_I32 }, { "str", 3, LEX_STR }, { "fn", 2, LEX_FN }, { "if", 2, LEX_IF },
+			{ "else", 4, LEX_ELSE }, { "let", 3, LEX_LET }, { "ret", 3, LEX_RET }, { "echo", 4, LEX_ECHO },
+			{ "main", 4, LEX_MAIN },
+			{ "(", 1, LEX_OPENING_PARENTHESIS }, { ")", 1, LEX_CLOSING_PARENTHESIS },
+			{ ";", 1, LEX_SEMICOLON }, { ",", 1, LEX_COMMA },
+			{ "{", 1, LEX_OPENING_CURLY_BRACE }, { "}", 1, LEX_CLOSING_CURLY_BRACE },
+			{ "+", 1, LEX_PLUS }, { "-", 1, LEX_MINUS }, { "*", 1, LEX_ASTERISK },
+			{ "/", 1, LEX_SLASH }, { "%", 1, LEX_PERCENT },
+			{ "=", 1, LEX_ASSIGN }
+		};
+		constexpr int spellingsCount = sizeof(spellings) / sizeof(spellings[0]);
+		constexpr size_t maxLength = 4;
+
+		// 64   : ';'  '{', '='  '}'    64
+		constexpr unsigned tableSize = 128;
+
+		constexpr unsigned slot(unsigned multiplier, unsigned char first, unsigned char last, size_t length)
+		{
+			return (first + last * multiplier + static_cast<unsigned>(length)) & (tableSize - 1);
+		}
+
+		constexpr bool isPerfect(unsigned multiplier)
+		{
+			bool used[tableSize]{};
+			for (const Spelling& spelling : spellings)
+			{
+				const unsigned s = slot(multiplier, spelling.text[0], spelling.text[spelling.length - 1], spelling.length);
+				if (used[s])
+					return false;
+				used[s] = true;
+			}
+			return true;
+		}
+
+		//    ,        
+		constexpr unsigned findMultiplier()
+		{
+			for (unsigned multiplier = 1; multiplier < 1024; ++multiplier)
+				if (isPerfect(multiplier))
+					return multiplier;
+			return 0;
+		}
+
+		constexpr unsigned multiplier = findMultiplier();
+		static_assert(multiplier != 0, "keywords: perfect hash multiplier not found");
+
+		//      ,      ;   - 0
+		constexpr unsigned long long pack(const char* text, size_t length)
+		{
+			unsigned long long key = static_cast<unsigned long long>(length) << 32;
+			for (size_t i = 0; i < length; ++i)
+				key |= static_cast<unsigned long long>(static_cast<unsigned char>(text[i])) << (8 * i);
+			return key;
+		}
+
+		struct Table
+		{
+			unsigned long long key[tableSize];
+			char lexeme[tableSize];
+		};
+
+		constexpr Table makeTable()
+		{
+			Table table{};
+			for (const Spelling& spelling : spellings)
+			{
+				const unsigned s = slot(multiplier, spelling.text[0], spelling.text[spelling.length - 1], spelling.length);
+				table.key[s] = pack(spelling.text, spelling.length);
+				table.lexeme[s] = spelling.lexeme;
+			}
+			return table;
+		}
+
+		constexpr Table table = makeTable();
+
+		//      , '\0' -  str    
+		inline char find(std::string_view str)
+		{
+			if (str.empty() || str.size() > maxLength)
+				return '\0';
+
+			const unsigned s = slot(multiplier, str.front(), str.back(), str.size());
+			return table.key[s] == pack(str.data(), str.size()) ? table.lexeme[s] : '\0';
+		}
+	}
+}
@@ -3,64 +3,146 @@
 #include "Error.h"
 
 TTM::LexTable::LexTable(size_t capacity)
-	: m_table()
 {
-	m_table.reserve(capacity);
+	m_lexemes.reserve(capacity);
+	m_lines.reserve(capacity);
+	m_idIndices.reserve(capacity);
 }
 
 void TTM::LexTable::addEntry(const LexTable::Entry& entry)
 {
-	m_table.push_back(entry);
+	m_lexemes.push_back(entry.lexeme);
+	m_lines.push_back(entry.lineNumber);
+	m_idIndices.push_back(entry.idTableIndex);
+	++m_counts[static_cast<unsigned char>(entry.lexeme)];
+}
+
+void TTM::LexTable::set(size_t index, const Entry& entry)
+{
+	setLexeme(index, entry.lexeme);
+	m_lines[index] = entry.lineNumber;
+	m_idIndices[index] = entry.idTableIndex;
+}
+
+void TTM::LexTable::setLexeme(size_t index, char lexeme)
+{
+	--m_counts[static_cast<unsigned char>(m_lexemes[index])];
+	++m_counts[static_cast<unsigned char>(lexeme)];
+	m_lexemes[index] = lexeme;
 }
 
 TTM::LexTable::Entry::Entry(char lexeme, int lineNumber, int idTableIndex)
 	: lexeme(lexeme), lineNumber(lineNumber), idTableIndex(idTableIndex)
 {	}
 
-const std::string TTM::LexTable::dumpTable(size_t startIndex, size_t endIndex) const
+void TTM::LexTable::dumpTable(BufferedWriter& output, dump::format format, size_t startIndex, size_t endIndex) const
 {
-	std::stringstream output;
-
-	startIndex = std::clamp(startIndex, 0U, m_table.size());
+	startIndex = std::clamp(startIndex, 0U, m_lexemes.size());
 	if (endIndex == 0)
 	{
-		endIndex = m_table.size();
+		endIndex = m_lexemes.size();
 	}
 	else
 	{
-		endIndex = std::clamp(endIndex, startIndex, m_table.size());
+		endIndex = std::clamp(endIndex, startIndex, m_lexemes.size());
 	}
-	output << std::setw(4) << "index" << std::setw(20) << "lexeme" << std::setw(25) << "idTable index\n";
 
+	if (format == dump::format::tsv)
+	{
+		output << "index\tlexeme\tidTable index\n";
+		for (size_t i = startIndex; i < endIndex; ++i)
+		{
+			output << i << '\t';
+			if (m_lexemes[i])
+				output << m_lexemes[i];
+			output << '\t';
+			if (m_idIndices[i] != TI_NULLIDX)
+				output << m_idIndices[i];
+			output << '\n';
+		}
+		return;
+	}
+
+	output.right("index", 4).right("lexeme", 20).right("idTable index\n", 25);
 	for (size_t i = startIndex; i < endIndex; ++i)
 	{
-		output << std::setw(4) << i;
-		if (m_table[i].lexeme)
+		output.right(i, 4);
+		if (m_lexemes[i])
 		{
-			output << std::setw(18) << '\'' << m_table[i].lexeme << '\'';
+			output.right("'", 18) << m_lexemes[i] << '\'';
 		}
-		if (m_table[i].idTableIndex != TI_NULLIDX)
+		if (m_idIndices[i] != TI_NULLIDX)
 		{
-			output << std::setw(19) << m_table[i].idTableIndex;
+			output.right(m_idIndices[i], 19);
 		}
 		output << '\n';
 	}
+}
+
+void TTM::LexTable::assign(size_t count, const char* lexemes, const int* lines, const int* idTableIndices)
+{
+	m_lexemes.assign(lexemes, lexemes + count);
+	m_lines.assign(lines, lines + count);
+	m_idIndices.assign(idTableIndices, idTableIndices + count);
 
-	return output.str();
+	std::fill(std::begin(m_counts), std::end(m_counts), 0);
+	for (char lexeme : m_lexemes)
+		++m_counts[static_cast<unsigned char>(lexeme)];
 }
 
-bool TTM::LexTable::hasLexeme(char lexeme) const
+int TTM::LexTable::lowerBoundByLine(int lineNumber) const
 {
-	for (const auto& e : m_table)
+	return std::lower_bound(m_lines.begin(), m_lines.end(), lineNumber) - m_lines.begin();
+}
+
+void TTM::LexTable::replace(int begin, int end, const std::vector<Entry>& entries)
+{
+	const int common = std::min(end - begin, static_cast<int>(entries.size()));
+	for (int i = 0; i < common; ++i)
+		set(begin + i, entries[i]);
+
+	if (end - begin > common)
 	{
-		if (e.lexeme == lexeme)
-			return true;
+		for (int i = begin + common; i < end; ++i)
+			--m_counts[static_cast<unsigned char>(m_lexemes[i])];
+
+		m_lexemes.erase(m_lexemes.begin() + begin + common, m_lexemes.begin() + end);
+		m_lines.erase(m_lines.begin() + begin + common, m_lines.begin() + end);
+		m_idIndices.erase(m_idIndices.begin() + begin + common, m_idIndices.begin() + end);
 	}
+	else if (entries.size() > static_cast<size_t>(common))
+	{
+		//        entries,     
+		const size_t count = entries.size() - common;
+		m_lexemes.insert(m_lexemes.begin() + end, count, '\0');
+		m_lines.insert(m_lines.begin() + end, count, 0);
+		m_idIndices.insert(m_idIndices.begin() + end, count, TI_NULLIDX);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Entry& entry = entries[common + i];
+			m_lexemes[end + i] = entry.lexeme;
+			m_lines[end + i] = entry.lineNumber;
+			m_idIndices[end + i] = entry.idTableIndex;
+			++m_counts[static_cast<unsigned char>(entry.lexeme)];
+		}
+	}
+}
+
+void TTM::LexTable::shiftLines(int from, int delta)
+{
+	if (delta == 0)
+		return;
 
-	return false;
+	for (size_t i = from; i < m_lines.size(); ++i)
+		m_lines[i] += delta;
 }
 
-int TTM::LexTable::lexemeCount(char lexeme) const
+void TTM::LexTable::remapIdTableIndices(const std::pmr::vector<int>& remap)
 {
-	return std::count_if(m_table.begin(), m_table.end(), [&](const Entry& e) {return e.lexeme == lexeme; });
-}
\ No newline at end of file
+	//       :      
+	for (int& index : m_idIndices)
+	{
+		if (index != TI_NULLIDX)
+			index = remap[index];
+	}
+}
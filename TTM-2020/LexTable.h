@@ -7,6 +7,8 @@
 #define LEX_ID							'i'
 #define LEX_DATATYPE					't'
 #define LEX_FUNCTION_CALL				'@'
+//      ;      idTableIndex
+#define LEX_ARGUMENTS_COUNT				'#'
 #define LEX_INTEGER_LITERAL				'1'
 #define LEX_STRING_LITERAL				'2'
 #define LEX_LITERAL						'l'
@@ -47,40 +49,62 @@ namespace TTM
 
 		LexTable(size_t capacity = 0);
 		void addEntry(const LexTable::Entry& entry);
-		const std::string dumpTable(size_t startIndex = 0, size_t endIndex = 0) const;
+		//  [startIndex, endIndex)   output; endIndex == 0 -   
+		void dumpTable(BufferedWriter& output, dump::format format = dump::format::text, size_t startIndex = 0, size_t endIndex = 0) const;
 
 		bool declaredFunction() const
 		{
-			return m_table.size() >= 2 && m_table[m_table.size() - 2].lexeme == LEX_FN;
+			return m_lexemes.size() >= 2 && m_lexemes[m_lexemes.size() - 2] == LEX_FN;
 		}
 
 		bool declaredVariable() const
 		{
-			return m_table.size() >= 2 && m_table[m_table.size() - 2].lexeme == LEX_LET;
+			return m_lexemes.size() >= 2 && m_lexemes[m_lexemes.size() - 2] == LEX_LET;
 		}
 
 		bool declaredDatatype() const
 		{
-			return m_table.size() >= 1 && (m_table[m_table.size() - 1].lexeme == LEX_DATATYPE);
+			return m_lexemes.size() >= 1 && (m_lexemes[m_lexemes.size() - 1] == LEX_DATATYPE);
 		}
 
-		int size() const { return m_table.size(); }
+		int size() const { return m_lexemes.size(); }
 
-		bool hasLexeme(char lexeme) const;
+		//        ,     
+		bool hasLexeme(char lexeme) const { return lexemeCount(lexeme) > 0; }
+		int lexemeCount(char lexeme) const { return m_counts[static_cast<unsigned char>(lexeme)]; }
 
-		int lexemeCount(char lexeme) const;
+		//      lineNumber  :    
+		int lowerBoundByLine(int lineNumber) const;
+		//   [begin, end)  entries,        
+		void replace(int begin, int end, const std::vector<Entry>& entries);
+		void shiftLines(int from, int delta);
+		//       : remap[ ] - 
+		void remapIdTableIndices(const std::pmr::vector<int>& remap);
 
-		Entry& operator[](size_t index)
-		{
-			return m_table[index];
-		}
+		//    index;     ,    
+		void set(size_t index, const Entry& entry);
+		void setLexeme(size_t index, char lexeme);
 
-		const Entry& operator[](size_t index) const
+		//   :         
+		char lexeme(size_t index) const { return m_lexemes[index]; }
+		int lineNumber(size_t index) const { return m_lines[index]; }
+		int idTableIndex(size_t index) const { return m_idIndices[index]; }
+
+		Entry operator[](size_t index) const
 		{
-			return m_table[index];
+			return { m_lexemes[index], m_lines[index], m_idIndices[index] };
 		}
 
+		//  ,   
+		const char* lexemes() const { return m_lexemes.data(); }
+		const int* lines() const { return m_lines.data(); }
+		const int* idTableIndices() const { return m_idIndices.data(); }
+		void assign(size_t count, const char* lexemes, const int* lines, const int* idTableIndices);
+
 	private:
-		std::vector<Entry> m_table;
+		std::pmr::vector<char> m_lexemes;
+		std::pmr::vector<int> m_lines;
+		std::pmr::vector<int> m_idIndices;
+		int m_counts[256] = { };
 	};
 }
\ No newline at end of file
@@ -1,233 +1,490 @@
 #include "pch.h"
 #include "LexicalAnalyzer.h"
 #include "FST.h"
+#include "Keywords.h"
+#include "Parallel.h"
 
-TTM::LexicalAnalyzer::LexicalAnalyzer(LexTable& lextable, IdTable& idtable)
-	: lextable(lextable), idtable(idtable)
+TTM::LexicalAnalyzer::LexicalAnalyzer(LexTable& lextable, IdTable& idtable, in::encoding encoding)
+	: lextable(lextable), idtable(idtable), m_encoding(encoding)
 {	}
 
-char TTM::LexicalAnalyzer::tokenize(const std::string& str)
+bool TTM::LexicalAnalyzer::isUtf8StringLiteral(std::string_view str)
 {
-	FST::FST fst[] = {
-		FST_I32, FST_STR, FST_FN, FST_IF, FST_ELSE, FST_LET,
-		FST_RET, FST_ECHO, FST_MAIN,
-		FST_OPENING_PARENTHESIS, FST_CLOSING_PARENTHESIS, FST_SEMICOLON, FST_COMMA,
-		FST_OPENING_CURLY_BRACE, FST_CLOSING_CURLY_BRACE,
-		FST_PLUS, FST_MINUS, FST_ASTERISK, FST_SLASH, FST_PERCENT,
-		FST_ASSIGN,
-		FST_ID, FST_STRING_LITERAL, FST_INTEGER_LITERAL
-	};
-	const int size = sizeof(fst) / sizeof(fst[0]);
-	const char tokens[] = {
-		LEX_I32, LEX_STR, LEX_FN, LEX_IF, LEX_ELSE, LEX_LET,
-		LEX_RET, LEX_ECHO, LEX_MAIN,
-		LEX_OPENING_PARENTHESIS, LEX_CLOSING_PARENTHESIS, LEX_SEMICOLON, LEX_COMMA,
-		LEX_OPENING_CURLY_BRACE, LEX_CLOSING_CURLY_BRACE,
-		LEX_PLUS, LEX_MINUS, LEX_ASTERISK, LEX_SLASH, LEX_PERCENT,
-		LEX_ASSIGN,
-		LEX_ID, LEX_STRING_LITERAL, LEX_INTEGER_LITERAL
-	};
-
-	for (int i = 0; i < size; ++i) {
-		if (execute(str, fst[i]))
+	if (str.size() < 2 || str.front() != '\'' || str.back() != '\'')
+		return false;
+
+	//   ASCII,   FST_STRING_LITERAL,   :     
+	for (unsigned char c : str.substr(1, str.size() - 2))
+		if ((c < ' ' || c > '~' || c == '\'') && c < 0x80)
+			return false;
+
+	return true;
+}
+
+char TTM::LexicalAnalyzer::tokenize(std::string_view str) const
+{
+	//      ,  UTF-8       
+	if (m_encoding == in::encoding::utf8 && !str.empty() && str.front() == '\'')
+		return isUtf8StringLiteral(str) ? LEX_STRING_LITERAL : EOF;
+
+	//          ,     
+	if (const char lexeme = keywords::find(str))
+		return lexeme;
+
+	return tokenAutomaton().execute(str);
+}
+
+void TTM::LexicalAnalyzer::tokenFsts(std::vector<std::unique_ptr<FST::FST>>& fsts, std::string& lexemes)
+{
+	//     -    ,    keywords::find,   
+	for (const keywords::Spelling& spelling : keywords::spellings)
+	{
+		fsts.push_back(std::make_unique<FST::FST>(std::string_view(spelling.text, spelling.length)));
+		lexemes += spelling.lexeme;
+	}
+
+	fsts.push_back(std::unique_ptr<FST::FST>(DBG_NEW FST_ID));
+	lexemes += LEX_ID;
+	fsts.push_back(std::unique_ptr<FST::FST>(DBG_NEW FST_STRING_LITERAL));
+	lexemes += LEX_STRING_LITERAL;
+	fsts.push_back(std::unique_ptr<FST::FST>(DBG_NEW FST_INTEGER_LITERAL));
+	lexemes += LEX_INTEGER_LITERAL;
+}
+
+const FST::DFA& TTM::LexicalAnalyzer::tokenAutomaton()
+{
+	//       ,       
+	static const FST::DFA automaton = []()
+	{
+		std::vector<std::unique_ptr<FST::FST>> fsts;
+		std::string lexemes;
+		tokenFsts(fsts, lexemes);
+
+		std::vector<const FST::FST*> pointers;
+		for (const auto& fst : fsts)
+			pointers.push_back(fst.get());
+		return FST::DFA(pointers.data(), lexemes.data(), static_cast<int>(pointers.size()));
+	}();
+
+	return automaton;
+}
+
+void TTM::LexicalAnalyzer::includeStdlibFunctions()
+{
+	const IdTable::symbol parseInt = idtable.intern("parseInt");
+	idtable.addEntry({ parseInt, Interner::empty, TI_NULLIDX, it::data_type::i32, it::id_type::function });
+	idtable.addEntry({ idtable.intern("s"), parseInt, TI_NULLIDX, it::data_type::str, it::id_type::parameter });
+
+	const IdTable::symbol concat = idtable.intern("concat");
+	idtable.addEntry({ concat, Interner::empty, TI_NULLIDX, it::data_type::str, it::id_type::function });
+	idtable.addEntry({ idtable.intern("a"), concat, TI_NULLIDX, it::data_type::str, it::id_type::parameter });
+	idtable.addEntry({ idtable.intern("b"), concat, TI_NULLIDX, it::data_type::str, it::id_type::parameter });
+}
+
+void TTM::LexicalAnalyzer::Scan(std::string_view source, const std::vector<in::TokenSpan>& tokens, Logger& log)
+{
+	ScanState state;
+	m_literalsCounter = 0;
+
+	//         - int
+	if (tokens.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+		throw ERROR_THROW(133);
+
+	includeStdlibFunctions();
+
+	//      ,       ,
+	//        
+	std::vector<char> lexemes(tokens.size());
+	const size_t chunksCount = parallel::workersCount(tokens.size(), minTokensPerThread);
+	std::vector<size_t> calls(chunksCount);
+	parallel::forEach(chunksCount, [&](size_t chunk)
+	{
+		const size_t end = tokens.size() * (chunk + 1) / chunksCount;
+		size_t count = 0;
+		for (size_t i = tokens.size() * chunk / chunksCount; i < end; ++i)
 		{
-			return tokens[i];
+			lexemes[i] = tokenize(source.substr(tokens[i].offset, tokens[i].length));
+			++count;
 		}
+		//       ,        
+		calls[chunk] = count;
+	});
+	for (size_t count : calls)
+		m_tokenizeCalls += count;
+	m_tokensCount += tokens.size();
+
+	for (size_t i = 0; i < tokens.size(); ++i)
+	{
+		const std::string_view name = source.substr(tokens[i].offset, tokens[i].length);
+		scanToken(state, lextable, name, tokens[i].line, lexemes[i], (i < tokens.size() - 1) ? lexemes[i + 1] : EOF);
 	}
 
-	return EOF;
+	if (!lextable.hasLexeme(LEX_MAIN))
+		throw ERROR_THROW(130);
+
+	if (lextable.lexemeCount(LEX_OPENING_PARENTHESIS) != lextable.lexemeCount(LEX_CLOSING_PARENTHESIS)
+		|| lextable.lexemeCount(LEX_OPENING_CURLY_BRACE) != lextable.lexemeCount(LEX_CLOSING_CURLY_BRACE))
+		throw ERROR_THROW(122);
+
+	log << "    \n";
 }
 
-void TTM::LexicalAnalyzer::includeStdlibFunctions()
+double TTM::LexicalAnalyzer::tokenizeCallsPerToken() const
 {
-	idtable.addEntry({ "parseInt", "", TI_NULLIDX, it::data_type::i32, it::id_type::function, "0" });
-	idtable.addEntry({ "s", "parseInt", TI_NULLIDX, it::data_type::str, it::id_type::parameter, "0" });
+	return m_tokensCount ? static_cast<double>(m_tokenizeCalls) / m_tokensCount : 0.0;
+}
 
-	idtable.addEntry({ "concat", "", TI_NULLIDX, it::data_type::str, it::id_type::function, "0" });
-	idtable.addEntry({ "a", "concat", TI_NULLIDX, it::data_type::str, it::id_type::parameter, "0" });
-	idtable.addEntry({ "b", "concat", TI_NULLIDX, it::data_type::str, it::id_type::parameter, "0" });
+bool TTM::LexicalAnalyzer::isLocalLexeme(char lexeme)
+{
+	switch (lexeme)
+	{
+	case LEX_FN:
+	case LEX_MAIN:
+	case LEX_LET:
+	case LEX_I32:
+	case LEX_STR:
+	case LEX_DATATYPE:
+	case LEX_OPENING_CURLY_BRACE:
+	case LEX_CLOSING_CURLY_BRACE:
+	case EOF:
+		return false;
+	default:
+		return true;
+	}
 }
 
-void TTM::LexicalAnalyzer::Scan(const std::vector<std::pair<std::string, int>>& sourceCode, Logger& log)
+bool TTM::LexicalAnalyzer::Rescan(std::string_view editedLines, int firstLine, int lastLine, Logger& log)
 {
-	using type = it::data_type;
-	using id_t = it::id_type;
+	const int begin = lextable.lowerBoundByLine(firstLine);
+	const int end = lextable.lowerBoundByLine(lastLine + 1);
+
+	//          ; ,  
+	//  ,    .      
+	m_movedLiterals.clear();
+	int parenthesesBalance = 0;
+	for (int i = begin; i < end; ++i)
+	{
+		const LexTable::Entry e = lextable[i];
+		if (!isLocalLexeme(e.lexeme))
+			return false;
+		if (e.idTableIndex != TI_NULLIDX && idtable[e.idTableIndex].lexTableIndex >= begin)
+		{
+			if (idtable[e.idTableIndex].idType != it::id_type::literal)
+				return false;
+			m_movedLiterals.push_back(e.idTableIndex);
+		}
+		parenthesesBalance += (e.lexeme == LEX_OPENING_PARENTHESIS) - (e.lexeme == LEX_CLOSING_PARENTHESIS);
+	}
+
+	InputFileReader in;
+	try
+	{
+		in.readText(editedLines, m_encoding, firstLine);
+	}
+	catch (Error::ERROR)
+	{
+		return false;
+	}
 
-	std::string currentScope = "";
-	std::string previousScope = currentScope;
-	std::string lastFunctionName = "";
+	const std::vector<in::TokenSpan>& tokens = in.tokens();
+	std::vector<char> lexemes(tokens.size());
+	m_tokensCount += tokens.size();
+	for (size_t i = 0; i < tokens.size(); ++i)
+	{
+		lexemes[i] = tokenize(in.source().substr(tokens[i].offset, tokens[i].length));
+		++m_tokenizeCalls;
+		if (!isLocalLexeme(lexemes[i]))
+			return false;
+	}
 
-	int literalsCounter = 0;
-	id_t idType = id_t::unknown;
-	type dataType = type::undefined;
+	//        :   ';'  '{',   ';'
+	const bool empty = begin == end && tokens.empty();
+	if (!empty && (begin == 0 || (lextable.lexeme(begin - 1) != LEX_SEMICOLON && lextable.lexeme(begin - 1) != LEX_OPENING_CURLY_BRACE)))
+		return false;
+	if ((begin != end && lextable.lexeme(end - 1) != LEX_SEMICOLON) || (!tokens.empty() && lexemes.back() != LEX_SEMICOLON))
+		return false;
 
-	bool unaryMinusCorrection = false;
+	//       -  ,        fn
+	ScanState state;
+	if (!empty)
+	{
+		int function = begin - 1;
+		while (function >= 0 && lextable.lexeme(function) != LEX_FN)
+			--function;
+		if (function < 0 || function + 2 >= begin || lextable.idTableIndex(function + 2) == TI_NULLIDX)
+			return false;
+
+		state.lastFunctionName = idtable[lextable.idTableIndex(function + 2)].name;
+		state.currentScope = state.lastFunctionName;
+		state.previousScope = state.lastFunctionName;
+	}
 
-	includeStdlibFunctions();
+	//         ,    
+	const int context = std::min(begin, 2);
+	LexTable table{ context + tokens.size() * 2 };
+	for (int i = begin - context; i < begin; ++i)
+		table.addEntry(lextable[i]);
+
+	//              
+	const int idTableSize = idtable.size();
+	const int literalsCounter = m_literalsCounter;
+	try
+	{
+		for (size_t i = 0; i < tokens.size(); ++i)
+		{
+			const char nextToken = (i < tokens.size() - 1) ? lexemes[i + 1] : (end < lextable.size()) ? lextable.lexeme(end) : EOF;
+			scanToken(state, table, in.source().substr(tokens[i].offset, tokens[i].length), tokens[i].line, lexemes[i], nextToken);
+		}
+	}
+	catch (Error::ERROR)
+	{
+		idtable.truncate(idTableSize);
+		m_literalsCounter = literalsCounter;
+		return false;
+	}
 
-	for (size_t i = 0; i < sourceCode.size(); ++i)
+	std::vector<LexTable::Entry> entries;
+	entries.reserve(table.size() - context);
+	for (int i = context; i < table.size(); ++i)
 	{
-		const auto& [name, lineNumber] = sourceCode[i];
-		char token = tokenize(name);
-		if (token == EOF)
+		//       ,    ;  
+		//  ,    ,      
+		const int index = table[i].idTableIndex;
+		if (index != TI_NULLIDX && (index >= idTableSize || idtable[index].lexTableIndex >= begin))
 		{
-			throw ERROR_THROW_LEX(129, lineNumber);
+			if (idtable[index].idType != it::id_type::literal)
+				break;
+			m_movedLiterals.push_back(index);
 		}
+		entries.push_back(table[i]);
+		parenthesesBalance -= (table[i].lexeme == LEX_OPENING_PARENTHESIS) - (table[i].lexeme == LEX_CLOSING_PARENTHESIS);
+	}
+	if (state.unaryMinusCorrection || static_cast<int>(entries.size()) != table.size() - context || parenthesesBalance != 0)
+	{
+		idtable.truncate(idTableSize);
+		m_literalsCounter = literalsCounter;
+		return false;
+	}
+
+	int linesCount = static_cast<int>(std::count(editedLines.begin(), editedLines.end(), in::endl));
+	if (!editedLines.empty() && editedLines.back() != in::endl)
+		++linesCount;
 
-		int idTableIndex = TI_NULLIDX;
+	const int entriesDelta = static_cast<int>(entries.size()) - (end - begin);
+	lextable.replace(begin, end, entries);
+	lextable.shiftLines(begin + static_cast<int>(entries.size()), linesCount - (lastLine - firstLine + 1));
+	idtable.shiftLexTableIndices(end, entriesDelta);
+	if (!m_movedLiterals.empty())
+		relocateLiterals(begin);
 
-		switch (token)
+	log << "    " << firstLine << '-' << lastLine << "   \n";
+	return true;
+}
+
+void TTM::LexicalAnalyzer::relocateLiterals(int begin)
+{
+	std::sort(m_movedLiterals.begin(), m_movedLiterals.end());
+	m_movedLiterals.erase(std::unique(m_movedLiterals.begin(), m_movedLiterals.end()), m_movedLiterals.end());
+	for (int index : m_movedLiterals)
+		idtable[index].lexTableIndex = TI_NULLIDX;
+
+	//      ; ,    , .
+	//     ,     
+	size_t pending = m_movedLiterals.size();
+	for (int i = begin; i < lextable.size() && pending > 0; ++i)
+	{
+		const int index = lextable.idTableIndex(i);
+		if (index != TI_NULLIDX && idtable[index].lexTableIndex == TI_NULLIDX
+			&& std::binary_search(m_movedLiterals.begin(), m_movedLiterals.end(), index))
 		{
-		case LEX_MAIN:
-			idTableIndex = idtable.getIdIndexByName("", name);
-			if (idTableIndex == TI_NULLIDX)
-			{
-				if (!lextable.declaredFunction())
-					throw ERROR_THROW_LEX(120, lineNumber);
-				if (dataType != type::i32)
-					throw ERROR_THROW_LEX(121, lineNumber);
-
-				idTableIndex = idtable.addEntry({ name, "", lextable.size(), dataType, id_t::function, "0" });
-				idType = id_t::unknown;
-				dataType = type::undefined;
-				lastFunctionName = name;
-			}
-			else if (lextable.declaredFunction())
-			{
-				throw ERROR_THROW_LEX(131, lineNumber);
-			}
-			break;
+			idtable[index].lexTableIndex = i;
+			--pending;
+		}
+	}
 
-		case LEX_ID:
-			if (i < sourceCode.size() - 1 && tokenize(sourceCode[i + 1].first) == LEX_OPENING_PARENTHESIS)
-			{
-				idTableIndex = idtable.getIdIndexByName("", name);
-			}
-			else
+	m_removedLiterals.clear();
+	for (int index : m_movedLiterals)
+	{
+		if (idtable[index].lexTableIndex == TI_NULLIDX)
+			m_removedLiterals.push_back(index);
+	}
+
+	// ,           ,   
+	//     
+	const IdTable::Entry* entries = idtable.entries();
+	if (m_removedLiterals.empty() && std::is_sorted(entries, entries + idtable.size(),
+		[](const IdTable::Entry& a, const IdTable::Entry& b) { return a.lexTableIndex < b.lexTableIndex; }))
+		return;
+
+	//  L0, L1, ...    ,    
+	for (int n = static_cast<int>(m_literalNames.size()); n < m_literalsCounter; ++n)
+		m_literalNames.push_back(idtable.intern("L" + std::to_string(n)));
+
+	lextable.remapIdTableIndices(idtable.reorder(m_removedLiterals, m_literalNames));
+	m_literalsCounter -= static_cast<int>(m_removedLiterals.size());
+}
+
+void TTM::LexicalAnalyzer::scanToken(ScanState& state, LexTable& table, std::string_view name, int lineNumber, char token, char nextToken)
+{
+	using type = it::data_type;
+	using id_t = it::id_type;
+
+	if (token == EOF)
+	{
+		throw ERROR_THROW_LEX(129, lineNumber);
+	}
+
+	int idTableIndex = TI_NULLIDX;
+	//      ,        
+	const IdTable::symbol symbol = (token == LEX_ID || token == LEX_MAIN) ? idtable.intern(name) : Interner::none;
+
+	switch (token)
+	{
+	case LEX_MAIN:
+		idTableIndex = idtable.getIdIndexByName(Interner::empty, symbol);
+		if (idTableIndex == TI_NULLIDX)
+		{
+			if (!table.declaredFunction())
+				throw ERROR_THROW_LEX(120, lineNumber);
+			if (state.dataType != type::i32)
+				throw ERROR_THROW_LEX(121, lineNumber);
+
+			idTableIndex = idtable.addEntry({ symbol, Interner::empty, table.size(), state.dataType, id_t::function });
+			state.idType = id_t::unknown;
+			state.dataType = type::undefined;
+			state.lastFunctionName = symbol;
+		}
+		else if (table.declaredFunction())
+		{
+			throw ERROR_THROW_LEX(131, lineNumber);
+		}
+		break;
+
+	case LEX_ID:
+		if (nextToken == LEX_OPENING_PARENTHESIS)
+		{
+			idTableIndex = idtable.getIdIndexByName(Interner::empty, symbol);
+		}
+		else
+		{
+			idTableIndex = idtable.getIdIndexByName(state.currentScope, symbol);
+		}
+		if (idTableIndex == TI_NULLIDX)
+		{
+			if (table.declaredFunction())
 			{
-				idTableIndex = idtable.getIdIndexByName(currentScope, name);
+				state.lastFunctionName = symbol;
+				state.currentScope = Interner::empty;
+				state.idType = id_t::function;
 			}
-			if (idTableIndex == TI_NULLIDX)
+			else if (table.declaredVariable())
 			{
-				if (lextable.declaredFunction())
-				{
-					lastFunctionName = name;
-					currentScope = "";
-					idType = id_t::function;
-				}
-				else if (lextable.declaredVariable())
-				{
-					idType = id_t::variable;
-				}
-				else if (lextable.declaredDatatype())
-				{
-					idType = id_t::parameter;
-				}
-				else
-				{
-					throw ERROR_THROW_LEX(124, lineNumber);
-				}
-
-				if (idType == id_t::unknown)
-					throw ERROR_THROW_LEX(120, lineNumber);
-				if (dataType == type::undefined)
-					throw ERROR_THROW_LEX(121, lineNumber);
-
-				idTableIndex = idtable.addEntry({ name, currentScope, lextable.size(), dataType, idType, "0" });
-				idType = id_t::unknown;
-				dataType = type::undefined;
+				state.idType = id_t::variable;
 			}
-			else if (lextable.declaredVariable() || lextable.declaredFunction() || lextable.declaredDatatype())
+			else if (table.declaredDatatype())
 			{
-				throw ERROR_THROW_LEX(123, lineNumber);
+				state.idType = id_t::parameter;
 			}
-			else if (name == currentScope)
+			else
 			{
-				throw ERROR_THROW_LEX(125, lineNumber);
+				throw ERROR_THROW_LEX(124, lineNumber);
 			}
-			break;
-
-		case LEX_I32:
-			dataType = type::i32;
-			token = LEX_DATATYPE;
-			break;
 
-		case LEX_STR:
-			dataType = type::str;
-			token = LEX_DATATYPE;
-			break;
+			if (state.idType == id_t::unknown)
+				throw ERROR_THROW_LEX(120, lineNumber);
+			if (state.dataType == type::undefined)
+				throw ERROR_THROW_LEX(121, lineNumber);
 
-		case LEX_INTEGER_LITERAL:
-			idTableIndex = idtable.getLiteralIndexByValue(atoi(name.c_str()));
-			if (idTableIndex == TI_NULLIDX)
-			{
-				idTableIndex = idtable.addEntry({ "L" + std::to_string(literalsCounter), "", lextable.size(), type::i32, id_t::literal, name.c_str() });
-				++literalsCounter;
-			}
-			token = LEX_LITERAL;
-			break;
+			idTableIndex = idtable.addEntry({ symbol, state.currentScope, table.size(), state.dataType, state.idType });
+			state.idType = id_t::unknown;
+			state.dataType = type::undefined;
+		}
+		else if (table.declaredVariable() || table.declaredFunction() || table.declaredDatatype())
+		{
+			throw ERROR_THROW_LEX(123, lineNumber);
+		}
+		else if (symbol == state.currentScope)
+		{
+			throw ERROR_THROW_LEX(125, lineNumber);
+		}
+		break;
 
-		case LEX_STRING_LITERAL:
-			if (name == "''")
-				throw ERROR_THROW_LEX(126, lineNumber);
+	case LEX_I32:
+		state.dataType = type::i32;
+		token = LEX_DATATYPE;
+		break;
 
-			idTableIndex = idtable.getLiteralIndexByValue(name.c_str());
-			if (idTableIndex == TI_NULLIDX)
-			{
-				idTableIndex = idtable.addEntry({ "L" + std::to_string(literalsCounter), "", lextable.size(), type::str, id_t::literal, name.c_str() });
-				++literalsCounter;
-			}
-			token = LEX_LITERAL;
-			break;
-
-		case LEX_OPENING_CURLY_BRACE:
-		case LEX_OPENING_PARENTHESIS:
-			previousScope = currentScope;
-			currentScope = lastFunctionName;
-			break;
-
-		case LEX_CLOSING_CURLY_BRACE:
-		case LEX_CLOSING_PARENTHESIS:
-			currentScope = previousScope;
-			break;
-
-		case LEX_MINUS:
-			if (lextable[lextable.size() - 1].lexeme == LEX_ASSIGN
-				|| lextable[lextable.size() - 1].lexeme == LEX_OPENING_PARENTHESIS
-				|| lextable[lextable.size() - 1].lexeme == LEX_RET)
-			{
-				lextable.addEntry({ LEX_OPENING_PARENTHESIS, lineNumber, TI_NULLIDX });
-				int tmp = idtable.getLiteralIndexByValue(0);
-				if (tmp == TI_NULLIDX)
-				{
-					tmp = idtable.addEntry({ "L" + std::to_string(literalsCounter), "", lextable.size(), type::i32, id_t::literal, "0" });
-					++literalsCounter;
-				}
-				lextable.addEntry({ LEX_LITERAL, lineNumber, tmp });
-				unaryMinusCorrection = true;
-			}
-			break;
+	case LEX_STR:
+		state.dataType = type::str;
+		token = LEX_DATATYPE;
+		break;
 
-		default:
-			break;
+	case LEX_INTEGER_LITERAL:
+	{
+		const int value = atoi(std::string(name).c_str());
+		idTableIndex = idtable.getLiteralIndexByValue(value);
+		if (idTableIndex == TI_NULLIDX)
+		{
+			idTableIndex = idtable.addEntry({ idtable.intern("L" + std::to_string(m_literalsCounter)), Interner::empty, table.size(), type::i32, id_t::literal, value });
+			++m_literalsCounter;
 		}
+		token = LEX_LITERAL;
+		break;
+	}
 
-		lextable.addEntry({ token, lineNumber, idTableIndex });
+	case LEX_STRING_LITERAL:
+	{
+		if (name == "''")
+			throw ERROR_THROW_LEX(126, lineNumber);
 
-		if ((token == LEX_LITERAL || (token == LEX_ID
-			&& idtable[lextable[lextable.size() - 1].idTableIndex].idType != id_t::function)) && unaryMinusCorrection)
+		idTableIndex = idtable.getLiteralIndexByValue(name);
+		if (idTableIndex == TI_NULLIDX)
 		{
-			lextable.addEntry({ LEX_CLOSING_PARENTHESIS, lineNumber, TI_NULLIDX });
-			unaryMinusCorrection = false;
+			idTableIndex = idtable.addEntry({ idtable.intern("L" + std::to_string(m_literalsCounter)), Interner::empty, table.size(), type::str, id_t::literal }, name);
+			++m_literalsCounter;
 		}
+		token = LEX_LITERAL;
+		break;
 	}
 
-	if (!lextable.hasLexeme(LEX_MAIN))
-		throw ERROR_THROW(130);
+	case LEX_OPENING_CURLY_BRACE:
+	case LEX_OPENING_PARENTHESIS:
+		state.previousScope = state.currentScope;
+		state.currentScope = state.lastFunctionName;
+		break;
+
+	case LEX_CLOSING_CURLY_BRACE:
+	case LEX_CLOSING_PARENTHESIS:
+		state.currentScope = state.previousScope;
+		break;
+
+	case LEX_MINUS:
+		if (table[table.size() - 1].lexeme == LEX_ASSIGN
+			|| table[table.size() - 1].lexeme == LEX_OPENING_PARENTHESIS
+			|| table[table.size() - 1].lexeme == LEX_RET)
+		{
+			table.addEntry({ LEX_OPENING_PARENTHESIS, lineNumber, TI_NULLIDX });
+			int tmp = idtable.getLiteralIndexByValue(0);
+			if (tmp == TI_NULLIDX)
+			{
+				tmp = idtable.addEntry({ idtable.intern("L" + std::to_string(m_literalsCounter)), Interner::empty, table.size(), type::i32, id_t::literal });
+				++m_literalsCounter;
+			}
+			table.addEntry({ LEX_LITERAL, lineNumber, tmp });
+			state.unaryMinusCorrection = true;
+		}
+		break;
 
-	if (lextable.lexemeCount(LEX_OPENING_PARENTHESIS) != lextable.lexemeCount(LEX_CLOSING_PARENTHESIS)
-		|| lextable.lexemeCount(LEX_OPENING_CURLY_BRACE) != lextable.lexemeCount(LEX_CLOSING_CURLY_BRACE))
-		throw ERROR_THROW(122);
+	default:
+		break;
+	}
 
-	log << "    \n";
-}
\ No newline at end of file
+	table.addEntry({ token, lineNumber, idTableIndex });
+
+	if ((token == LEX_LITERAL || (token == LEX_ID
+		&& idtable[table[table.size() - 1].idTableIndex].idType != id_t::function)) && state.unaryMinusCorrection)
+	{
+		table.addEntry({ LEX_CLOSING_PARENTHESIS, lineNumber, TI_NULLIDX });
+		state.unaryMinusCorrection = false;
+	}
+}
@@ -2,20 +2,68 @@
 #include "Logger.h"
 #include "LexTable.h"
 #include "IdTable.h"
+#include "InputFileReader.h"
+#include "FST.h"
 
 namespace TTM
 {
 	class LexicalAnalyzer
 	{
 	public:
-		LexicalAnalyzer(LexTable& lextable, IdTable& idtable);
+		LexicalAnalyzer(LexTable& lextable, IdTable& idtable, in::encoding encoding = in::encoding::cp1251);
 
-		void Scan(const std::vector<std::pair<std::string, int>>& sourceCode, Logger& log);
+		void Scan(std::string_view source, const std::vector<in::TokenSpan>& tokens, Logger& log);
+
+		//    [firstLine, lastLine]  Scan,   editedLines ( );
+		// false,        -    Scan.
+		//    ,   : ,      
+		//    ,   O(N)      
+		bool Rescan(std::string_view editedLines, int firstLine, int lastLine, Logger& log);
+
+		//  FST      :  keywords::spellings,  FST_ID  
+		static void tokenFsts(std::vector<std::unique_ptr<FST::FST>>& fsts, std::string& lexemes);
+		//     tokenFsts
+		static const FST::DFA& tokenAutomaton();
+
+		//          Scan  Rescan;  
+		//     ,     1.0
+		double tokenizeCallsPerToken() const;
+		size_t tokenizeCalls() const { return m_tokenizeCalls; }
 	private:
+		//      
+		struct ScanState
+		{
+			IdTable::symbol currentScope = Interner::empty;
+			IdTable::symbol previousScope = Interner::empty;
+			IdTable::symbol lastFunctionName = Interner::empty;
+			it::id_type idType = it::id_type::unknown;
+			it::data_type dataType = it::data_type::undefined;
+			bool unaryMinusCorrection = false;
+		};
+
+		//        
+		static constexpr size_t minTokensPerThread = 1 << 14;
+
 		LexTable& lextable;
 		IdTable& idtable;
+		in::encoding m_encoding;
+		int m_literalsCounter = 0;
+		size_t m_tokenizeCalls = 0;
+		size_t m_tokensCount = 0;
+		// ,       Rescan,    
+		std::pmr::vector<int> m_movedLiterals;
+		std::pmr::vector<int> m_removedLiterals;
+		//   L0, L1, ... -    
+		std::pmr::vector<IdTable::symbol> m_literalNames;
 
-		char tokenize(const std::string& str);
+		char tokenize(std::string_view str) const;
+		static bool isUtf8StringLiteral(std::string_view str);
+		//         
+		static bool isLocalLexeme(char lexeme);
+		void scanToken(ScanState& state, LexTable& table, std::string_view name, int lineNumber, char token, char nextToken);
 		void includeStdlibFunctions();
+		//      begin:  m_movedLiterals      
+		//   ,    ,       
+		void relocateLiterals(int begin);
 	};
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "pch.h"
+#include "Arena.h"
 #include "SyntaxAnalyzer.h"
 #include "Error.h"
 #include "FST.h"
@@ -13,6 +14,7 @@
 #include "SemanticAnalyzer.h"
 #include "CodeGeneration.h"
 #include "LexicalAnalyzer.h"
+#include "Snapshot.h"
 
 int main(int argc, char** argv)
 {
@@ -22,6 +24,14 @@ int main(int argc, char** argv)
 
 	try
 	{
+		//      ;      
+		Arena arena;
+		auto logArena = [&log, &arena](const char* phase)
+		{
+			log << ", " << phase << ": +" << arena.phaseUsed() << " ,  " << arena.used()
+				<< "  " << arena.highWater() << " \n";
+		};
+
 		CommandLineArgumentsParser commandLineArguments{ argc, argv };
 		log.setLogFilePath(commandLineArguments.logFilePath());
 		log.openFile();
@@ -34,60 +44,111 @@ int main(int argc, char** argv)
 		for (std::string p : parametersList)
 			log << p << '\n';
 
+		// ,     ,  ,     
+		const snapshot::phase snapshotPhase = commandLineArguments.snapshot()
+			? snapshot::phaseByName(commandLineArguments.snapshotPhase()) : snapshot::phase::none;
+		snapshot::phase resumedPhase = snapshot::phase::none;
+
 		InputFileReader in;
-		in.read(commandLineArguments.inFilePath());
+		if (!commandLineArguments.resume())
+		{
+			in.read(commandLineArguments.inFilePath(), commandLineArguments.utf8() ? in::encoding::utf8 : in::encoding::cp1251);
 
-		log << "----   ------" << '\n' <<
-			" : " << in.fileSize() << '\n' <<
-			": " << in.ignoredCharsCount() << '\n' <<
-			" : " << in.linesCount() << '\n'
-			<< "-----------------------------------------------------------\n";
+			log << "----   ------" << '\n' <<
+				" : " << in.fileSize() << '\n' <<
+				": " << in.ignoredCharsCount() << '\n' <<
+				" : " << in.linesCount() << '\n'
+				<< "-----------------------------------------------------------\n";
+		}
 
-		auto splitted = InputFileReader::splitStringByDelimiter(in.fileText(), in::delimiter);
-		LexTable lextable{ splitted.size() };
+		LexTable lextable{ in.tokens().size() };
 		IdTable idtable{};
 
-		LexicalAnalyzer lexicalAnalyzer{ lextable, idtable };
-		lexicalAnalyzer.Scan(splitted, log);
+		auto finishPhase = [&](snapshot::phase phase, const char* name)
+		{
+			logArena(name);
+			if (phase == snapshotPhase)
+			{
+				snapshot::write(commandLineArguments.snapshotFilePath(), phase, lextable, idtable);
+				log << "    \n";
+			}
+		};
 
-		SyntaxAnalyzer syntaxAnalyzer{ lextable, GRB::getGreibach() };
-		syntaxAnalyzer.Start(log);
+		if (commandLineArguments.resume())
+		{
+			resumedPhase = snapshot::read(commandLineArguments.snapshotFilePath(), lextable, idtable);
+			log << "   ,  " << snapshot::phaseName(resumedPhase) << '\n';
+		}
+		else
+		{
+			LexicalAnalyzer lexicalAnalyzer{ lextable, idtable, in.encoding() };
+			lexicalAnalyzer.Scan(in.source(), in.tokens(), log);
+			finishPhase(snapshot::phase::lexical, " ");
+		}
 
-		SemanticAnalyzer semanticAnalyzer{ lextable, idtable };
-		semanticAnalyzer.Start(log);
+		const GRB::Greibach greibach = GRB::getGreibach();
+		//        
+		std::unique_ptr<BufferedWriter> traceFile;
+		if (commandLineArguments.trace())
+			traceFile = std::make_unique<BufferedWriter>(commandLineArguments.traceFilePath());
+		SyntaxAnalyzer syntaxAnalyzer{ lextable, greibach, traceFile.get() };
+		if (resumedPhase < snapshot::phase::syntax && commandLineArguments.ll1())
+		{
+			GRB::PredictiveTable table{ greibach };
+			for (const std::string& conflict : table.conflicts())
+				log << " LL(1): " << conflict << '\n';
+			syntaxAnalyzer.Start(log, table);
+			finishPhase(snapshot::phase::syntax, " ");
+		}
+		else if (resumedPhase < snapshot::phase::syntax)
+		{
+			syntaxAnalyzer.Start(log);
+			finishPhase(snapshot::phase::syntax, " ");
+		}
 
-		PolishNotation(lextable, idtable);
+		if (resumedPhase < snapshot::phase::semantic)
+		{
+			SemanticAnalyzer semanticAnalyzer{ lextable, idtable };
+			semanticAnalyzer.Start(log);
+			finishPhase(snapshot::phase::semantic, " ");
+		}
+
+		if (resumedPhase < snapshot::phase::polish)
+		{
+			PolishNotation(lextable, idtable);
+			finishPhase(snapshot::phase::polish, " ");
+		}
 
 		Generator codeGenerator{ lextable, idtable, commandLineArguments.outFilePath() };
 		codeGenerator.Start(log);
+		logArena(" ");
 
 		log << "-----------------------------------------------------------\n";
-		if (commandLineArguments.lexTableFilePath())
+		const dump::format dumpFormat = commandLineArguments.tsv() ? dump::format::tsv : dump::format::text;
+		if (commandLineArguments.lexTable())
 		{
-			std::ofstream lexTableFile(commandLineArguments.lexTableFilePath());
-			lexTableFile << lextable.dumpTable();
-			lexTableFile.close();
+			BufferedWriter lexTableFile(commandLineArguments.lexTableFilePath());
+			lextable.dumpTable(lexTableFile, dumpFormat);
+			lexTableFile.flush();
 			log << "    \n";
 		}
-		if (commandLineArguments.idTableFilePath())
+		if (commandLineArguments.idTable())
 		{
-			std::ofstream idTableFile(commandLineArguments.idTableFilePath());
-			idTableFile << idtable.dumpTable();
-			idTableFile.close();
+			BufferedWriter idTableFile(commandLineArguments.idTableFilePath());
+			idtable.dumpTable(idTableFile, dumpFormat);
+			idTableFile.flush();
 			log << "    \n";
 		}
-		if (commandLineArguments.traceFilePath())
+		if (traceFile)
 		{
-			std::ofstream traceFile(commandLineArguments.traceFilePath());
-			traceFile << syntaxAnalyzer.dumpTrace();
-			traceFile.close();
+			traceFile->flush();
 			log << "    \n";
 		}
-		if (commandLineArguments.rulesFilePath())
+		if (commandLineArguments.rules())
 		{
-			std::ofstream rulesFile(commandLineArguments.rulesFilePath());
-			rulesFile << syntaxAnalyzer.getRules();
-			rulesFile.close();
+			BufferedWriter rulesFile(commandLineArguments.rulesFilePath());
+			syntaxAnalyzer.dumpRules(rulesFile, dumpFormat);
+			rulesFile.flush();
 			log << "    \n";
 		}
 		log << "-----------------------------------------------------------\n";
@@ -0,0 +1,121 @@
+#include "pch.h"
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+TTM::MappedFile::MappedFile()
+	: m_data(nullptr), m_size(0), m_isOpen(false)
+{	}
+
+TTM::MappedFile::~MappedFile()
+{
+	close();
+}
+
+#ifdef _WIN32
+
+bool TTM::MappedFile::open(const char* filePath)
+{
+	close();
+
+	HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	//    , CreateFileMapping     
+	if (fileSize.QuadPart > 0)
+	{
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping != nullptr)
+		{
+			m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			CloseHandle(mapping);
+		}
+
+		if (m_data == nullptr)
+		{
+			CloseHandle(file);
+			return false;
+		}
+	}
+
+	CloseHandle(file);
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+	m_isOpen = true;
+
+	return true;
+}
+
+void TTM::MappedFile::close()
+{
+	if (m_data != nullptr)
+		UnmapViewOfFile(m_data);
+
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpen = false;
+}
+
+#else
+
+bool TTM::MappedFile::open(const char* filePath)
+{
+	close();
+
+	int file = ::open(filePath, O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0)
+	{
+		::close(file);
+		return false;
+	}
+
+	if (fileStat.st_size > 0)
+	{
+		void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		if (view == MAP_FAILED)
+		{
+			::close(file);
+			return false;
+		}
+		m_data = static_cast<const char*>(view);
+	}
+
+	::close(file);
+	m_size = static_cast<size_t>(fileStat.st_size);
+	m_isOpen = true;
+
+	return true;
+}
+
+void TTM::MappedFile::close()
+{
+	if (m_data != nullptr)
+		munmap(const_cast<char*>(m_data), m_size);
+
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpen = false;
+}
+
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace TTM
+{
+	class MappedFile
+	{
+	public:
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool open(const char* filePath);
+		void close();
+
+		const char* data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool isOpen() const { return m_isOpen; }
+
+	private:
+		const char* m_data;
+		size_t m_size;
+		bool m_isOpen;
+	};
+}
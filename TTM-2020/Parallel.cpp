@@ -0,0 +1,21 @@
+#include "pch.h"
+#include "Parallel.h"
+
+namespace
+{
+	std::atomic<size_t> maxWorkersLimit{ 0 };
+}
+
+size_t TTM::parallel::workersCount(size_t workSize, size_t minWorkPerThread)
+{
+	size_t maxWorkers = maxWorkersLimit.load();
+	if (maxWorkers == 0)
+		maxWorkers = std::max(1U, std::thread::hardware_concurrency());
+
+	return std::clamp(workSize / std::max(minWorkPerThread, static_cast<size_t>(1)), static_cast<size_t>(1), maxWorkers);
+}
+
+void TTM::parallel::setMaxWorkers(size_t maxWorkers)
+{
+	maxWorkersLimit = maxWorkers;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+namespace TTM
+{
+	namespace parallel
+	{
+		//      workSize,       minWorkPerThread
+		size_t workersCount(size_t workSize, size_t minWorkPerThread);
+
+		//   , 0 -    
+		void setMaxWorkers(size_t maxWorkers);
+
+		//  function(i)  i  [0, count):     ,   ;
+		//           
+		template<class Function>
+		void forEach(size_t count, Function function)
+		{
+			if (count <= 1)
+			{
+				if (count == 1)
+					function(0);
+				return;
+			}
+
+			std::vector<std::exception_ptr> errors(count);
+			auto run = [&](size_t i)
+			{
+				try
+				{
+					function(i);
+				}
+				catch (...)
+				{
+					errors[i] = std::current_exception();
+				}
+			};
+
+			std::vector<std::thread> workers;
+			workers.reserve(count - 1);
+			for (size_t i = 1; i < count; ++i)
+				workers.emplace_back(run, i);
+			run(0);
+			for (std::thread& worker : workers)
+				worker.join();
+
+			for (std::exception_ptr& error : errors)
+				if (error)
+					std::rethrow_exception(error);
+		}
+	}
+}
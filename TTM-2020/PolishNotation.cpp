@@ -6,7 +6,7 @@ TTM::PolishNotation::PolishNotation(LexTable& lextable, IdTable& idtable)
 {
 	for (int i = 0; i < lextable.size(); ++i)
 	{
-		if (lextable[i].lexeme == LEX_ASSIGN || lextable[i].lexeme == LEX_RET)
+		if (lextable.lexeme(i) == LEX_ASSIGN || lextable.lexeme(i) == LEX_RET)
 		{
 			convert(i + 1);
 		}
@@ -26,16 +26,18 @@ int TTM::PolishNotation::getOperationsPriority(char operation)
 
 bool TTM::PolishNotation::convert(int startIndex)
 {
-	std::vector<LexTable::Entry> infixExpressionEntries;
+	std::pmr::vector<LexTable::Entry>& infixExpressionEntries = m_infix;
+	infixExpressionEntries.clear();
 	int operandsCounter = 0, operationsCounter = 0;
 	bool functionParameters = false;
 
-	for (int i = startIndex; i < lextable.size() && lextable[i - 1].lexeme != LEX_SEMICOLON; ++i)
+	for (int i = startIndex; i < lextable.size() && lextable.lexeme(i - 1) != LEX_SEMICOLON; ++i)
 	{
-		char& lexeme = lextable[i].lexeme;
-		if (lextable[i].idTableIndex != TI_NULLIDX && idtable[lextable[i].idTableIndex].idType == it::id_type::function)
+		char lexeme = lextable.lexeme(i);
+		if (lextable.idTableIndex(i) != TI_NULLIDX && idtable[lextable.idTableIndex(i)].idType == it::id_type::function)
 		{
 			lexeme = LEX_FUNCTION_CALL;
+			lextable.setLexeme(i, lexeme);
 			functionParameters = true;
 			++operandsCounter;
 		}
@@ -58,24 +60,25 @@ bool TTM::PolishNotation::convert(int startIndex)
 	if (operandsCounter - operationsCounter != 1)
 		return false;
 
-	std::vector<LexTable::Entry> postfixExpressionEntries = getPostfixExpression(infixExpressionEntries);
+	const std::pmr::vector<LexTable::Entry>& postfixExpressionEntries = getPostfixExpression(infixExpressionEntries);
 	for (size_t i = 0; i < infixExpressionEntries.size(); ++i) {
 		if (i < postfixExpressionEntries.size()) {
-			lextable[i + startIndex] = postfixExpressionEntries[i];
+			lextable.set(i + startIndex, postfixExpressionEntries[i]);
 		}
 		else {
-			lextable[i + startIndex] = { FORBIDDEN_SYMBOL, EOF, EOF };
+			lextable.set(i + startIndex, { FORBIDDEN_SYMBOL, EOF, EOF });
 		}
 	}
 
 	return true;
 }
 
-std::vector<TTM::LexTable::Entry> TTM::PolishNotation::getPostfixExpression(const std::vector<LexTable::Entry>& entries)
+const std::pmr::vector<TTM::LexTable::Entry>& TTM::PolishNotation::getPostfixExpression(const std::pmr::vector<LexTable::Entry>& entries)
 {
-	std::vector<LexTable::Entry> output;
+	std::pmr::vector<LexTable::Entry>& output = m_postfix;
+	output.clear();
 	output.reserve(entries.size());
-	std::stack<LexTable::Entry> stack;
+	auto& stack = m_operators;
 	bool foundFunction = false;
 
 	for (const auto& e : entries)
@@ -121,7 +124,7 @@ std::vector<TTM::LexTable::Entry> TTM::PolishNotation::getPostfixExpression(cons
 			if (!stack.empty() && stack.top().lexeme == LEX_FUNCTION_CALL)
 			{
 				output.push_back(stack.top());
-				output.push_back({ getFunctionParametersCountByName(idtable[stack.top().idTableIndex].name), TI_NULLIDX, TI_NULLIDX });
+				output.push_back({ LEX_ARGUMENTS_COUNT, TI_NULLIDX, getFunctionParametersCountByName(idtable[stack.top().idTableIndex].name) });
 				stack.pop();
 				foundFunction = false;
 			}
@@ -143,14 +146,14 @@ std::vector<TTM::LexTable::Entry> TTM::PolishNotation::getPostfixExpression(cons
 	return output;
 }
 
-char TTM::PolishNotation::getFunctionParametersCountByName(const std::string& functionName)
+int TTM::PolishNotation::getFunctionParametersCountByName(IdTable::symbol functionName)
 {
 	int parametersCount = 0;
-	int index = idtable.getIdIndexByName("", functionName);
+	int index = idtable.getIdIndexByName(Interner::empty, functionName);
 	for (int i = index + 1; idtable[i].idType == it::id_type::parameter; ++i)
 	{
 		++parametersCount;
 	}
 
-	return parametersCount + '0';
+	return parametersCount;
 }
\ No newline at end of file
@@ -14,10 +14,14 @@ namespace TTM
 	private:
 		LexTable& lextable;
 		IdTable& idtable;
+		//     :      
+		std::pmr::vector<LexTable::Entry> m_infix;
+		std::pmr::vector<LexTable::Entry> m_postfix;
+		std::stack<LexTable::Entry, std::pmr::vector<LexTable::Entry>> m_operators;
 
 		int getOperationsPriority(char operation);
 		bool convert(int startIndex);
-		std::vector<LexTable::Entry> getPostfixExpression(const std::vector<LexTable::Entry>& entries);
-		char getFunctionParametersCountByName(const std::string& functionName);
+		const std::pmr::vector<LexTable::Entry>& getPostfixExpression(const std::pmr::vector<LexTable::Entry>& entries);
+		int getFunctionParametersCountByName(IdTable::symbol functionName);
 	};
 }
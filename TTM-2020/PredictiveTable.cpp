@@ -0,0 +1,217 @@
+#include "pch.h"
+#include "PredictiveTable.h"
+
+GRB::PredictiveTable::Node::Node(short nrule)
+	: nrule(nrule), endChain(-1), firstChain(-1)
+{
+	std::fill(std::begin(actions), std::end(actions), reject);
+}
+
+GRB::PredictiveTable::PredictiveTable(const Greibach& greibach)
+	: m_greibach(greibach)
+{
+	buildTree();
+	buildSets();
+	buildActions();
+}
+
+void GRB::PredictiveTable::buildTree()
+{
+	std::fill(std::begin(m_rules), std::end(m_rules), -1);
+	//   ,     ,  ;      
+	size_t symbols = m_greibach.size;
+	for (short r = 0; r < m_greibach.size; ++r)
+	{
+		for (short c = 0; c < m_greibach.rules[r].size; ++c)
+			symbols += m_greibach.rules[r].chains[c].size;
+	}
+	m_nodes.reserve(symbols);
+	m_roots.reserve(m_greibach.size);
+
+	for (short r = 0; r < m_greibach.size; ++r)
+	{
+		m_rules[static_cast<unsigned char>(Rule::Chain::alphabet_to_char(m_greibach.rules[r].nn))] = r;
+		m_roots.push_back(m_nodes.size());
+		m_nodes.emplace_back(r);
+	}
+
+	for (short r = 0; r < m_greibach.size; ++r)
+	{
+		const Rule& rule = m_greibach.rules[r];
+		for (short c = 0; c < rule.size; ++c)
+		{
+			short n = m_roots[r];
+			if (m_nodes[n].firstChain < 0)
+				m_nodes[n].firstChain = c;
+
+			for (short i = 0; i < rule.chains[c].size; ++i)
+			{
+				const GRBALPHABET symbol = rule.chains[c].nt[i];
+				auto edge = std::find_if(m_nodes[n].edges.begin(), m_nodes[n].edges.end(),
+					[symbol](const Edge& e) { return e.symbol == symbol; });
+				if (edge != m_nodes[n].edges.end())
+				{
+					n = edge->next;
+					continue;
+				}
+
+				const short next = m_nodes.size();
+				m_nodes.emplace_back(r);
+				m_nodes[next].firstChain = c;
+				m_nodes[n].edges.push_back({ symbol, next });
+				n = next;
+			}
+
+			if (m_nodes[n].endChain < 0)
+				m_nodes[n].endChain = c;
+			else
+				m_conflicts.push_back(m_greibach.rules[r].getCRule(c) + ":  " + std::to_string(c)
+					+ "   " + std::to_string(m_nodes[n].endChain) + ",  ");
+		}
+	}
+}
+
+void GRB::PredictiveTable::buildSets()
+{
+	m_nullable.assign(m_nodes.size(), false);
+	m_first.assign(m_nodes.size(), terminals());
+
+	// -   ,        
+	for (bool changed = true; changed; )
+	{
+		changed = false;
+		for (size_t n = m_nodes.size(); n-- > 0; )
+		{
+			bool nullableNode = m_nodes[n].endChain >= 0;
+			terminals firstNode;
+			for (const Edge& e : m_nodes[n].edges)
+			{
+				firstNode |= first(e.symbol);
+				if (nullable(e.symbol))
+				{
+					firstNode |= m_first[e.next];
+					nullableNode = nullableNode || m_nullable[e.next];
+				}
+			}
+
+			if (nullableNode != m_nullable[n] || firstNode != m_first[n])
+			{
+				m_nullable[n] = nullableNode;
+				m_first[n] = firstNode;
+				changed = true;
+			}
+		}
+	}
+
+	m_follow.assign(m_greibach.size, terminals());
+	if (rule(m_greibach.startN) >= 0)
+		m_follow[rule(m_greibach.startN)].set(static_cast<unsigned char>(m_greibach.stbottomT));
+
+	for (bool changed = true; changed; )
+	{
+		changed = false;
+		for (const Node& node : m_nodes)
+		{
+			for (const Edge& e : node.edges)
+			{
+				const short r = rule(e.symbol);
+				if (r < 0)
+					continue;
+
+				terminals follow = m_follow[r] | m_first[e.next];
+				if (m_nullable[e.next])
+					follow |= m_follow[node.nrule];
+
+				if (follow != m_follow[r])
+				{
+					m_follow[r] = follow;
+					changed = true;
+				}
+			}
+		}
+	}
+}
+
+void GRB::PredictiveTable::buildActions()
+{
+	//  : (,  ,  ) -> 
+	std::map<std::tuple<short, short, short>, std::string> rejected;
+
+	for (short n = 0; n < static_cast<short>(m_nodes.size()); ++n)
+	{
+		Node& node = m_nodes[n];
+		std::vector<short> candidates;
+		for (int t = 1; t < 256; ++t)
+		{
+			candidates.clear();
+			for (short e = 0; e < static_cast<short>(node.edges.size()); ++e)
+			{
+				if (predict(node.nrule, node.edges[e]).test(t))
+					candidates.push_back(e);
+			}
+			if (node.endChain >= 0 && m_follow[node.nrule].test(t))
+				candidates.push_back(accept);
+
+			if (candidates.empty())
+				continue;
+
+			//     (  ,     ),
+			//   -      ,      
+			short chosen = candidates.front();
+			for (short candidate : candidates)
+			{
+				if (candidate != accept && m_nodes[node.edges[candidate].next].firstChain < m_nodes[node.edges[chosen].next].firstChain)
+					chosen = candidate;
+			}
+			node.actions[t] = chosen;
+
+			for (short candidate : candidates)
+			{
+				if (candidate != chosen)
+					rejected[std::make_tuple(n, chosen, candidate)] += static_cast<char>(t);
+			}
+		}
+	}
+
+	for (const auto& [key, lexemes] : rejected)
+	{
+		const auto [n, chosen, candidate] = key;
+		m_conflicts.push_back(describe(n, chosen) + "  " + describe(n, candidate) + "   '" + lexemes + "'");
+	}
+}
+
+bool GRB::PredictiveTable::nullable(GRBALPHABET symbol) const
+{
+	return rule(symbol) >= 0 && m_nullable[m_roots[rule(symbol)]];
+}
+
+GRB::PredictiveTable::terminals GRB::PredictiveTable::first(GRBALPHABET symbol) const
+{
+	terminals output;
+	if (Rule::Chain::isT(symbol))
+		output.set(static_cast<unsigned char>(symbol));
+	else if (rule(symbol) >= 0)
+		output = m_first[m_roots[rule(symbol)]];
+
+	return output;
+}
+
+GRB::PredictiveTable::terminals GRB::PredictiveTable::predict(short nrule, const Edge& edge) const
+{
+	terminals output = first(edge.symbol);
+	if (nullable(edge.symbol))
+	{
+		output |= m_first[edge.next];
+		if (m_nullable[edge.next])
+			output |= m_follow[nrule];
+	}
+
+	return output;
+}
+
+std::string GRB::PredictiveTable::describe(short n, short action) const
+{
+	const Node& node = m_nodes[n];
+	const short chain = (action == accept) ? node.endChain : m_nodes[node.edges[action].next].firstChain;
+	return m_greibach.rules[node.nrule].getCRule(chain);
+}
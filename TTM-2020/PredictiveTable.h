@@ -0,0 +1,71 @@
+#pragma once
+#include "Greibach.h"
+
+namespace GRB
+{
+	//    LL(1),    .
+	//          ( ):   - 
+	//  "  ",         
+	class PredictiveTable
+	{
+	public:
+		//   ,   
+		static constexpr short reject = -1;
+		static constexpr short accept = -2;
+
+		struct Edge
+		{
+			GRBALPHABET symbol;
+			short next;
+		};
+
+		struct Node
+		{
+			short nrule;
+			// ,    ,  -1
+			short endChain;
+			//   ,   
+			short firstChain;
+			std::pmr::vector<Edge> edges;
+			//  ->    edges, accept ( endChain )  reject
+			short actions[256];
+
+			Node(short nrule);
+		};
+
+		explicit PredictiveTable(const Greibach& greibach);
+
+		//     -1
+		short rule(GRBALPHABET nn) const { return Rule::Chain::isN(nn) ? m_rules[static_cast<unsigned char>(Rule::Chain::alphabet_to_char(nn))] : -1; }
+		short root(short nrule) const { return m_roots[nrule]; }
+		const Node& node(short n) const { return m_nodes[n]; }
+		short action(short n, GRBALPHABET t) const { return m_nodes[n].actions[static_cast<unsigned char>(t)]; }
+
+		// ,   ,    
+		const std::vector<std::string>& conflicts() const { return m_conflicts; }
+
+	private:
+		using terminals = std::bitset<256>;
+
+		Greibach m_greibach;
+		short m_rules[256];
+		std::pmr::vector<short> m_roots;
+		std::pmr::vector<Node> m_nodes;
+		std::vector<std::string> m_conflicts;
+
+		std::pmr::vector<bool> m_nullable;
+		std::pmr::vector<terminals> m_first;
+		// FOLLOW -  ,      ,    
+		std::pmr::vector<terminals> m_follow;
+
+		void buildTree();
+		void buildSets();
+		void buildActions();
+
+		bool nullable(GRBALPHABET symbol) const;
+		terminals first(GRBALPHABET symbol) const;
+		// ,     edge     nrule
+		terminals predict(short nrule, const Edge& edge) const;
+		std::string describe(short n, short action) const;
+	};
+}
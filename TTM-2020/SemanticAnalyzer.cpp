@@ -9,7 +9,7 @@ TTM::SemanticAnalyzer::SemanticAnalyzer(LexTable& lextable, IdTable& idtable)
 	{
 		if (idtable[i].idType == it::id_type::function)
 		{
-			std::string functionName = idtable[i].name;
+			const IdTable::symbol functionName = idtable[i].name;
 			for (int j = i + 1; j < idtable.size() && idtable[j].idType == it::id_type::parameter; ++j)
 			{
 				functionParametersList[functionName].push_back(idtable[j].dataType);
@@ -28,15 +28,16 @@ void TTM::SemanticAnalyzer::Start(Logger& log)
 	log << "    \n";
 }
 
-std::vector<TTM::it::data_type> TTM::SemanticAnalyzer::getFunctionParametersList(int startIndex)
+const std::pmr::vector<TTM::it::data_type>& TTM::SemanticAnalyzer::getFunctionParametersList(int startIndex)
 {
-	std::vector<it::data_type> argumentsList;
-	for (int i = startIndex; lextable[i].lexeme != LEX_CLOSING_PARENTHESIS; ++i)
+	std::pmr::vector<it::data_type>& argumentsList = m_arguments;
+	argumentsList.clear();
+	for (int i = startIndex; lextable.lexeme(i) != LEX_CLOSING_PARENTHESIS; ++i)
 	{
-		if (lextable[i].lexeme == LEX_ID && idtable[lextable[i].idTableIndex].idType != it::id_type::function
-			|| lextable[i].lexeme == LEX_LITERAL)
+		if (lextable.lexeme(i) == LEX_ID && idtable[lextable.idTableIndex(i)].idType != it::id_type::function
+			|| lextable.lexeme(i) == LEX_LITERAL)
 		{
-			argumentsList.push_back(idtable[lextable[i].idTableIndex].dataType);
+			argumentsList.push_back(idtable[lextable.idTableIndex(i)].dataType);
 		}
 	}
 
@@ -47,11 +48,11 @@ void TTM::SemanticAnalyzer::checkAssignmentTypeMismatch()
 {
 	for (int i = 0; i < lextable.size(); ++i)
 	{
-		if (lextable[i].lexeme == LEX_ASSIGN)
+		if (lextable.lexeme(i) == LEX_ASSIGN)
 		{
 			if (getPreviousOperandDataType(i - 1) != getNextOperandDataType(i + 1))
 			{
-				throw ERROR_THROW_LEX(706, lextable[i].lineNumber);
+				throw ERROR_THROW_LEX(706, lextable.lineNumber(i));
 			}
 		}
 	}
@@ -61,12 +62,12 @@ void TTM::SemanticAnalyzer::checkArithmeticOperations()
 {
 	for (int i = 0; i < lextable.size(); ++i)
 	{
-		if (lextable[i].lexeme == LEX_PLUS || lextable[i].lexeme == LEX_MINUS
-			|| lextable[i].lexeme == LEX_ASTERISK || lextable[i].lexeme == LEX_SLASH
-			|| lextable[i].lexeme == LEX_PERCENT)
+		if (lextable.lexeme(i) == LEX_PLUS || lextable.lexeme(i) == LEX_MINUS
+			|| lextable.lexeme(i) == LEX_ASTERISK || lextable.lexeme(i) == LEX_SLASH
+			|| lextable.lexeme(i) == LEX_PERCENT)
 		{
 			if (getPreviousOperandDataType(i - 1) != it::data_type::i32 || getNextOperandDataType(i + 1) != it::data_type::i32)
-				throw ERROR_THROW_LEX(707, lextable[i].lineNumber);
+				throw ERROR_THROW_LEX(707, lextable.lineNumber(i));
 		}
 	}
 }
@@ -75,10 +76,10 @@ void TTM::SemanticAnalyzer::checkReturnTypeMismatch()
 {
 	for (int i = 0; i < lextable.size(); ++i)
 	{
-		if (lextable[i].lexeme == LEX_RET
+		if (lextable.lexeme(i) == LEX_RET
 			&& getNextOperandDataType(i + 1) != getFunctionReturnTypeFromDeclaration(i))
 		{
-			throw ERROR_THROW_LEX(700, lextable[i].lineNumber);
+			throw ERROR_THROW_LEX(700, lextable.lineNumber(i));
 		}
 	}
 }
@@ -87,7 +88,7 @@ void TTM::SemanticAnalyzer::checkParametersMismatch()
 {
 	for (int i = 0; i < lextable.size(); ++i)
 	{
-		if (lextable[i].lexeme == LEX_ASSIGN || lextable[i].lexeme == LEX_RET)
+		if (lextable.lexeme(i) == LEX_ASSIGN || lextable.lexeme(i) == LEX_RET)
 		{
 			parametersMismatch(i + 1);
 		}
@@ -96,14 +97,15 @@ void TTM::SemanticAnalyzer::checkParametersMismatch()
 
 void TTM::SemanticAnalyzer::parametersMismatch(int startIndex)
 {
-	for (int i = startIndex; i < lextable.size() && lextable[i].lexeme != LEX_SEMICOLON; ++i)
+	for (int i = startIndex; i < lextable.size() && lextable.lexeme(i) != LEX_SEMICOLON; ++i)
 	{
-		if (lextable[i].lexeme == LEX_ID && idtable[lextable[i].idTableIndex].idType == it::id_type::function)
+		if (lextable.lexeme(i) == LEX_ID && idtable[lextable.idTableIndex(i)].idType == it::id_type::function)
 		{
-			const std::string& functionName = idtable[lextable[i].idTableIndex].name;
-			if (functionParametersList[functionName] != getFunctionParametersList(i))
+			const IdTable::symbol functionName = idtable[lextable.idTableIndex(i)].name;
+			const auto parameters = functionParametersList.find(functionName);
+			if (getFunctionParametersList(i) != (parameters != functionParametersList.end() ? parameters->second : m_noParameters))
 			{
-				throw ERROR_THROW_LEX(701, lextable[i].lineNumber);
+				throw ERROR_THROW_LEX(701, lextable.lineNumber(i));
 			}
 		}
 	}
@@ -112,9 +114,9 @@ void TTM::SemanticAnalyzer::parametersMismatch(int startIndex)
 TTM::it::data_type TTM::SemanticAnalyzer::getNextOperandDataType(int startIndex) {
 	for (int i = startIndex; i < lextable.size(); ++i)
 	{
-		if (lextable[i].lexeme == LEX_ID || lextable[i].lexeme == LEX_LITERAL)
+		if (lextable.lexeme(i) == LEX_ID || lextable.lexeme(i) == LEX_LITERAL)
 		{
-			return idtable[lextable[i].idTableIndex].dataType;
+			return idtable[lextable.idTableIndex(i)].dataType;
 		}
 	}
 
@@ -125,14 +127,14 @@ TTM::it::data_type TTM::SemanticAnalyzer::getPreviousOperandDataType(int startIn
 	bool foundParenthesis = false;
 	for (int i = startIndex; i >= 0; --i)
 	{
-		if (lextable[i].lexeme == LEX_CLOSING_PARENTHESIS
+		if (lextable.lexeme(i) == LEX_CLOSING_PARENTHESIS
 			&& getFunctionDataType(i - 1) != it::data_type::undefined)
 		{
 			return getFunctionDataType(i - 1);
 		}
-		else if (lextable[i].lexeme == LEX_ID || lextable[i].lexeme == LEX_LITERAL)
+		else if (lextable.lexeme(i) == LEX_ID || lextable.lexeme(i) == LEX_LITERAL)
 		{
-			return idtable[lextable[i].idTableIndex].dataType;
+			return idtable[lextable.idTableIndex(i)].dataType;
 		}
 	}
 
@@ -143,9 +145,9 @@ TTM::it::data_type TTM::SemanticAnalyzer::getFunctionReturnTypeFromDeclaration(i
 {
 	for (int i = startIndex; i >= 0; --i)
 	{
-		if (lextable[i].lexeme == LEX_FN)
+		if (lextable.lexeme(i) == LEX_FN)
 		{
-			return idtable[lextable[i + 2].idTableIndex].dataType;
+			return idtable[lextable.idTableIndex(i + 2)].dataType;
 		}
 	}
 
@@ -156,8 +158,8 @@ TTM::it::data_type TTM::SemanticAnalyzer::getFunctionDataType(int startIndex)
 {
 	for (int i = startIndex; i >= 0; --i)
 	{
-		int previousElementIndex = lextable[i - 1].idTableIndex;
-		if (lextable[i].lexeme == LEX_OPENING_PARENTHESIS && previousElementIndex != TI_NULLIDX
+		int previousElementIndex = lextable.idTableIndex(i - 1);
+		if (lextable.lexeme(i) == LEX_OPENING_PARENTHESIS && previousElementIndex != TI_NULLIDX
 			&& idtable[previousElementIndex].idType == it::id_type::function)
 		{
 			return idtable[previousElementIndex].dataType;
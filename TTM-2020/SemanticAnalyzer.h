@@ -14,11 +14,15 @@ namespace TTM
 		LexTable& lextable;
 		IdTable& idtable;
 
-		using list_t = std::map<std::string, std::vector<it::data_type>>;
+		using list_t = std::pmr::unordered_map<IdTable::symbol, std::pmr::vector<it::data_type>>;
 
 		list_t functionParametersList;
+		//   :     ,      
+		std::pmr::vector<it::data_type> m_arguments;
+		//    ,    functionParametersList
+		const std::pmr::vector<it::data_type> m_noParameters;
 
-		std::vector<it::data_type> getFunctionParametersList(int startIndex);
+		const std::pmr::vector<it::data_type>& getFunctionParametersList(int startIndex);
 
 		void parametersMismatch(int startIndex);
 
@@ -0,0 +1,230 @@
+#include "pch.h"
+#include "Snapshot.h"
+#include "MappedFile.h"
+#include "Error.h"
+#include "PolishNotation.h"
+
+namespace
+{
+	using namespace TTM;
+
+	// "TTMS"    :        
+	constexpr unsigned magic = 'T' | ('T' << 8) | ('M' << 16) | ('S' << 24);
+	//         IdTable::Entry
+	constexpr unsigned version = 1;
+	constexpr size_t alignment = 8;
+
+	struct Header
+	{
+		unsigned magic;
+		unsigned version;
+		unsigned phase;
+		unsigned entrySize;
+		unsigned long long lexemesCount;
+		unsigned long long entriesCount;
+		unsigned long long stringsSize;
+		unsigned long long symbolsCount;
+		unsigned long long symbolsSize;
+	};
+
+	static_assert(std::is_trivially_copyable<IdTable::Entry>::value, "IdTable::Entry is written to snapshots as is");
+	static_assert(sizeof(Header) % alignment == 0, "snapshot sections must stay aligned");
+
+	size_t aligned(size_t size)
+	{
+		return (size + alignment - 1) / alignment * alignment;
+	}
+
+	// ,           
+	bool isTableLexeme(char lexeme)
+	{
+		switch (lexeme)
+		{
+		case LEX_ID: case LEX_DATATYPE: case LEX_LITERAL: case LEX_FUNCTION_CALL: case LEX_ARGUMENTS_COUNT:
+		case LEX_FN: case LEX_IF: case LEX_ELSE: case LEX_LET: case LEX_RET: case LEX_ECHO: case LEX_MAIN:
+		case LEX_SEMICOLON: case LEX_COMMA: case LEX_OPENING_CURLY_BRACE: case LEX_CLOSING_CURLY_BRACE:
+		case LEX_OPENING_PARENTHESIS: case LEX_CLOSING_PARENTHESIS:
+		case LEX_PLUS: case LEX_MINUS: case LEX_ASTERISK: case LEX_SLASH: case LEX_PERCENT: case LEX_ASSIGN:
+		case FORBIDDEN_SYMBOL:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	//    ,         
+	void writeSection(std::ofstream& out, const void* data, size_t size)
+	{
+		static const char padding[alignment] = { };
+		out.write(static_cast<const char*>(data), size);
+		out.write(padding, aligned(size) - size);
+	}
+
+	class Reader
+	{
+	public:
+		Reader(const char* data, size_t size)
+			: m_position(data), m_end(data + size)
+		{	}
+
+		//    :         
+		size_t remaining() const { return static_cast<size_t>(m_end - m_position); }
+
+		template<class T>
+		const T* section(size_t count)
+		{
+			//     ,     
+			if (count > remaining() / sizeof(T))
+				throw ERROR_THROW(115);
+			const size_t size = sizeof(T) * count;
+			if (remaining() < aligned(size))
+				throw ERROR_THROW(115);
+
+			const T* output = reinterpret_cast<const T*>(m_position);
+			m_position += aligned(size);
+			return output;
+		}
+
+	private:
+		const char* m_position;
+		const char* m_end;
+	};
+}
+
+TTM::snapshot::phase TTM::snapshot::phaseByName(const std::string& name)
+{
+	const phase phases[] = { phase::lexical, phase::syntax, phase::semantic, phase::polish };
+	for (phase p : phases)
+	{
+		if (name == phaseName(p))
+			return p;
+	}
+
+	throw ERROR_THROW(101);
+}
+
+const char* TTM::snapshot::phaseName(phase p)
+{
+	switch (p)
+	{
+	case phase::lexical:
+		return "lex";
+	case phase::syntax:
+		return "syntax";
+	case phase::semantic:
+		return "semantic";
+	case phase::polish:
+		return "polish";
+	default:
+		return "none";
+	}
+}
+
+void TTM::snapshot::write(const char* filePath, phase after, const LexTable& lextable, const IdTable& idtable)
+{
+	std::ofstream out(filePath, std::ios::binary);
+	if (!out)
+		throw ERROR_THROW(116);
+
+	const Interner& symbols = idtable.symbols();
+	std::vector<unsigned> lengths(symbols.size());
+	std::string text;
+	for (int s = 0; s < symbols.size(); ++s)
+	{
+		lengths[s] = static_cast<unsigned>(symbols.str(s).size());
+		text += symbols.str(s);
+	}
+
+	const Header header = {
+		magic, version, static_cast<unsigned>(after), sizeof(IdTable::Entry),
+		static_cast<unsigned long long>(lextable.size()), static_cast<unsigned long long>(idtable.size()),
+		idtable.strings().size(), lengths.size(), text.size()
+	};
+
+	writeSection(out, &header, sizeof(header));
+	writeSection(out, lextable.lexemes(), lextable.size());
+	writeSection(out, lextable.lines(), sizeof(int) * lextable.size());
+	writeSection(out, lextable.idTableIndices(), sizeof(int) * lextable.size());
+	writeSection(out, idtable.entries(), sizeof(IdTable::Entry) * idtable.size());
+	writeSection(out, idtable.strings().data(), idtable.strings().size());
+	writeSection(out, lengths.data(), sizeof(unsigned) * lengths.size());
+	writeSection(out, text.data(), text.size());
+
+	if (!out.flush())
+		throw ERROR_THROW(116);
+}
+
+TTM::snapshot::phase TTM::snapshot::read(const char* filePath, LexTable& lextable, IdTable& idtable)
+{
+	MappedFile file;
+	if (!file.open(filePath))
+		throw ERROR_THROW(114);
+
+	Reader reader(file.data(), file.size());
+	const Header& header = *reader.section<Header>(1);
+	if (header.magic != magic || header.version != version || header.entrySize != sizeof(IdTable::Entry)
+		|| header.phase < static_cast<unsigned>(phase::lexical) || header.phase > static_cast<unsigned>(phase::polish)
+		|| header.lexemesCount > static_cast<unsigned long long>(std::numeric_limits<int>::max()))
+		throw ERROR_THROW(115);
+	//          size_t:  32- 
+	//       
+	const unsigned long long counts[] = {
+		header.lexemesCount, header.entriesCount, header.stringsSize, header.symbolsCount, header.symbolsSize
+	};
+	for (unsigned long long count : counts)
+	{
+		if (count > reader.remaining())
+			throw ERROR_THROW(115);
+	}
+
+	const size_t lexemesCount = static_cast<size_t>(header.lexemesCount);
+	const char* lexemes = reader.section<char>(lexemesCount);
+	const int* lines = reader.section<int>(lexemesCount);
+	const int* idTableIndices = reader.section<int>(lexemesCount);
+	const IdTable::Entry* entries = reader.section<IdTable::Entry>(static_cast<size_t>(header.entriesCount));
+	const char* strings = reader.section<char>(static_cast<size_t>(header.stringsSize));
+	const unsigned* lengths = reader.section<unsigned>(static_cast<size_t>(header.symbolsCount));
+	const char* text = reader.section<char>(static_cast<size_t>(header.symbolsSize));
+
+	//    ,        
+	size_t offset = 0;
+	for (size_t s = 0; s < header.symbolsCount; ++s)
+	{
+		if (offset + lengths[s] > header.symbolsSize
+			|| idtable.intern(std::string_view(text + offset, lengths[s])) != static_cast<IdTable::symbol>(s))
+			throw ERROR_THROW(115);
+		offset += lengths[s];
+	}
+
+	//      ,        
+	for (size_t i = 0; i < lexemesCount; ++i)
+	{
+		//        LEX_ARGUMENTS_COUNT  ,   
+		const int index = idTableIndices[i];
+		if (!isTableLexeme(lexemes[i]))
+			throw ERROR_THROW(115);
+		if (lexemes[i] == LEX_ARGUMENTS_COUNT ? (index < 0 || static_cast<size_t>(index) > i)
+			: (index != TI_NULLIDX && (index < 0 || static_cast<unsigned long long>(index) >= header.entriesCount)))
+			throw ERROR_THROW(115);
+	}
+	for (size_t i = 0; i < header.entriesCount; ++i)
+	{
+		const IdTable::Entry& e = entries[i];
+		if (e.name < 0 || static_cast<unsigned long long>(e.name) >= header.symbolsCount
+			|| e.scope < 0 || static_cast<unsigned long long>(e.scope) >= header.symbolsCount)
+			throw ERROR_THROW(115);
+		//      :        
+		if (e.idType < it::id_type::variable || e.idType > it::id_type::literal
+			|| e.dataType < it::data_type::i32 || e.dataType > it::data_type::str)
+			throw ERROR_THROW(115);
+		if (e.idType == it::id_type::literal && e.dataType == it::data_type::str
+			&& (e.value.strValue.offset < 0 || e.value.strValue.length < 0
+				|| static_cast<unsigned long long>(e.value.strValue.offset) + e.value.strValue.length > header.stringsSize))
+			throw ERROR_THROW(115);
+	}
+
+	lextable.assign(lexemesCount, lexemes, lines, idTableIndices);
+	idtable.assign(entries, static_cast<size_t>(header.entriesCount), std::string_view(strings, static_cast<size_t>(header.stringsSize)));
+
+	return static_cast<phase>(header.phase);
+}
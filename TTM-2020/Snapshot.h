@@ -0,0 +1,22 @@
+#pragma once
+#include "LexTable.h"
+#include "IdTable.h"
+
+namespace TTM
+{
+	//          :   -snapshot,
+	//  -resume    .      ,   , 
+	//  -      ,   
+	namespace snapshot
+	{
+		enum class phase : unsigned { none, lexical, syntax, semantic, polish };
+
+		//      : lex, syntax, semantic, polish
+		phase phaseByName(const std::string& name);
+		const char* phaseName(phase p);
+
+		void write(const char* filePath, phase after, const LexTable& lextable, const IdTable& idtable);
+		//     ,  ,    
+		phase read(const char* filePath, LexTable& lextable, IdTable& idtable);
+	}
+}
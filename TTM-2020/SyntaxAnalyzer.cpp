@@ -4,14 +4,14 @@
 int FST_TRACE_n = -1;
 
 TTM::MfstState::MfstState()
-	: m_tape_position(0), m_nrule(-1), m_nrulechain(-1)
+	: m_tape_position(0), m_nrule(-1), m_nrulechain(-1), m_stack({ -1, 0 })
 {	}
 
-TTM::MfstState::MfstState(short position, MFSTSTACK m_stack, short m_nrulechain)
+TTM::MfstState::MfstState(int position, MfstStack::Snapshot m_stack, short m_nrulechain)
 	: m_tape_position(position), m_nrule(-1), m_nrulechain(m_nrulechain), m_stack(m_stack)
 {	}
 
-TTM::MfstState::MfstState(short position, MFSTSTACK m_stack, short m_nrule, short m_nrulechain)
+TTM::MfstState::MfstState(int position, MfstStack::Snapshot m_stack, short m_nrule, short m_nrulechain)
 	: m_tape_position(position), m_nrule(m_nrule), m_nrulechain(m_nrulechain), m_stack(m_stack)
 {	}
 
@@ -19,42 +19,46 @@ TTM::SyntaxAnalyzer::MfstDiagnosis::MfstDiagnosis()
 	: m_tape_position(-1), rc_step(RC_STEP::SURPRISE), m_nrule(-1), nrule_chain(-1)
 {	}
 
-TTM::SyntaxAnalyzer::MfstDiagnosis::MfstDiagnosis(short m_tape_position, RC_STEP rc_step, short m_nrule, short nrule_chain)
+TTM::SyntaxAnalyzer::MfstDiagnosis::MfstDiagnosis(int m_tape_position, RC_STEP rc_step, short m_nrule, short nrule_chain)
 	: m_tape_position(m_tape_position), rc_step(rc_step), m_nrule(m_nrule), nrule_chain(nrule_chain)
 {	}
 
 TTM::SyntaxAnalyzer::SyntaxAnalyzer()
-	: m_tape(nullptr), m_tape_position(0), m_nrule(-1), m_nrulechain(-1), m_tape_size(0), lextable({}), greibach({})
+	: m_tape_position(0), m_nrule(-1), m_nrulechain(-1), m_tape_size(0), lextable({}), greibach({}), m_chains(greibach), m_trace(nullptr)
 {	}
 
-TTM::SyntaxAnalyzer::SyntaxAnalyzer(const TTM::LexTable& lextable, const GRB::Greibach& greibach)
-	: m_tape_position(0), m_nrule(-1), m_nrulechain(-1), m_tape_size(lextable.size()), lextable(lextable), greibach(greibach)
+TTM::SyntaxAnalyzer::SyntaxAnalyzer(const TTM::LexTable& lextable, const GRB::Greibach& greibach, BufferedWriter* trace)
+	: m_tape_position(0), m_nrule(-1), m_nrulechain(-1), m_tape_size(lextable.size()), lextable(lextable), greibach(greibach), m_chains(greibach), m_trace(trace)
 {
-	m_tape = DBG_NEW short[m_tape_size];
+	m_tape.resize(m_tape_size);
 
 	for (int k = 0; k < m_tape_size; ++k) {
-		m_tape[k] = GRB::TS(lextable[k].lexeme);
+		m_tape[k] = GRB::TS(lextable.lexeme(k));
 	}
 
 	m_stack.push(greibach.stbottomT);
 	m_stack.push(greibach.startN);
 }
 
-std::string TTM::SyntaxAnalyzer::getCSt() {
+std::string TTM::MfstStack::str() const
+{
 	std::string output = "";
 
-	for (int k = (signed)m_stack.size() - 1; k >= 0; --k) {
-		short p = m_stack.c[k];
-		output.push_back(GRB::Rule::Chain::alphabet_to_char(p));
+	for (int k = m_top; k >= 0; k = m_pool[k].next) {
+		output.push_back(GRB::Rule::Chain::alphabet_to_char(m_pool[k].symbol));
 	}
 
 	return output;
 }
 
-std::string TTM::SyntaxAnalyzer::getCTape(short pos, short n) {
+std::string TTM::SyntaxAnalyzer::getCSt() {
+	return m_stack.str();
+}
+
+std::string TTM::SyntaxAnalyzer::getCTape(int pos, int n) {
 	std::string output = "";
-	short i;
-	short k = (pos + n < m_tape_size) ? pos + n : m_tape_size;
+	int i;
+	int k = (pos + n < m_tape_size) ? pos + n : m_tape_size;
 
 	for (i = pos; i < k; ++i) {
 		output.push_back(GRB::Rule::Chain::alphabet_to_char(m_tape[i]));
@@ -64,7 +68,7 @@ std::string TTM::SyntaxAnalyzer::getCTape(short pos, short n) {
 }
 
 bool TTM::SyntaxAnalyzer::save_state() {
-	m_storestate.push(MfstState(m_tape_position, m_stack, m_nrule, m_nrulechain));
+	m_storestate.push(MfstState(m_tape_position, m_stack.save(), m_nrule, m_nrulechain));
 	MFST_TRACE6("SAVESTATE:", m_storestate.size());
 	return true;
 }
@@ -76,7 +80,7 @@ bool TTM::SyntaxAnalyzer::restore_state() {
 	if (output = (m_storestate.size() > 0)) {
 		state = m_storestate.top();
 		m_tape_position = state.m_tape_position;
-		m_stack = state.m_stack;
+		m_stack.restore(state.m_stack);
 		m_nrule = state.m_nrule;
 		m_nrulechain = state.m_nrulechain;
 		m_storestate.pop();
@@ -87,7 +91,7 @@ bool TTM::SyntaxAnalyzer::restore_state() {
 	return output;
 }
 
-bool TTM::SyntaxAnalyzer::push_chain(GRB::Rule::Chain chain) {
+bool TTM::SyntaxAnalyzer::push_chain(const GRB::Rule::Chain& chain) {
 	for (int k = chain.size - 1; k >= 0; k--) {
 		m_stack.push(chain.nt[k]);
 	}
@@ -99,14 +103,14 @@ TTM::SyntaxAnalyzer::RC_STEP TTM::SyntaxAnalyzer::step() {
 	RC_STEP output = SyntaxAnalyzer::RC_STEP::SURPRISE;
 	if (m_tape_position < m_tape_size) {
 		if (GRB::Rule::Chain::isN(m_stack.top())) {
-			GRB::Rule rule;
-			if ((m_nrule = greibach.getRule(m_stack.top(), rule)) >= 0) {
-				GRB::Rule::Chain chain;
-				if ((m_nrulechain = rule.getNextChain(m_tape[m_tape_position], chain, m_nrulechain + 1)) >= 0) {
+			if ((m_nrule = m_chains.rule(m_stack.top())) >= 0) {
+				//        ,  -    
+				GRB::Rule& rule = greibach.rules[m_nrule];
+				if ((m_nrulechain = m_chains.nextChain(m_nrule, m_tape[m_tape_position], m_nrulechain)) >= 0) {
 					MFST_TRACE1
 						save_state();
 					m_stack.pop();
-					push_chain(chain);
+					push_chain(rule.chains[m_nrulechain]);
 					output = SyntaxAnalyzer::RC_STEP::NS_OK;
 					MFST_TRACE2
 				}
@@ -194,22 +198,120 @@ bool TTM::SyntaxAnalyzer::savediagnosis(RC_STEP rc_step) {
 	return output;
 }
 
-std::string TTM::SyntaxAnalyzer::getRules() {
-	MfstState state;
-	GRB::Rule rule;
-	for (unsigned short k = 0; k < m_storestate.size(); k++)
+void TTM::SyntaxAnalyzer::dumpRules(BufferedWriter& output, dump::format format)
+{
+	auto dumpRule = [&](int position, short nrule, short nrulechain)
+	{
+		GRB::Rule rule = greibach.getRule(nrule);
+		if (format == dump::format::tsv)
+			output << position << '\t' << rule.getCRule(nrulechain) << '\n';
+		else
+		{
+			output.left(position, 4) << ": ";
+			output.left(rule.getCRule(nrulechain), 20) << '\n';
+		}
+	};
+
+	for (size_t k = 0; k < m_storestate.size(); k++)
+	{
+		const MfstState& state = m_storestate.c[k];
+		dumpRule(state.m_tape_position, state.m_nrule, state.m_nrulechain);
+	}
+	for (const Derivation& step : m_derivation)
+		dumpRule(step.m_tape_position, step.m_nrule, step.m_nrulechain);
+}
+
+bool TTM::SyntaxAnalyzer::Start(Logger& log, const GRB::PredictiveTable& table)
+{
+	MFST_TRACE_START;
+
+	if (predict(table))
 	{
-		state = m_storestate.c[k];
-		rule = greibach.getRule(state.m_nrule);
-		m_rules << std::setw(4) << std::left << state.m_tape_position << ": "
-			<< std::setw(20) << std::left << rule.getCRule(state.m_nrulechain)
-			<< '\n';
+		MFST_TRACE4("------>TAPE_END");
+		log << "     (LL(1))\n";
+		return true;
 	}
 
-	return m_rules.str();
+	MFST_TRACE4("------>LL(1) REJECT");
+	log << "     " << m_tape_position << ",    \n";
+	reset();
+	return Start(log);
 }
 
-std::string TTM::SyntaxAnalyzer::dumpTrace() const
+bool TTM::SyntaxAnalyzer::predict(const GRB::PredictiveTable& table)
 {
-	return m_trace.str();
-}
\ No newline at end of file
+	std::pmr::vector<PredictiveItem> stack;
+	stack.push_back({ greibach.stbottomT, -1, -1 });
+	stack.push_back({ greibach.startN, -1, -1 });
+
+	while (m_tape_position < m_tape_size)
+	{
+		if (stack.empty())
+			return false;
+
+		const PredictiveItem item = stack.back();
+		const GRBALPHABET lexeme = m_tape[m_tape_position];
+		if (item.node >= 0)
+		{
+			const short action = table.action(item.node, lexeme);
+			if (action == GRB::PredictiveTable::reject)
+				return false;
+
+			stack.pop_back();
+			if (action == GRB::PredictiveTable::accept)
+			{
+				Derivation& step = m_derivation[item.state];
+				step.m_nrulechain = table.node(item.node).endChain;
+				MFST_TRACE7(step)
+				continue;
+			}
+
+			const GRB::PredictiveTable::Edge& edge = table.node(item.node).edges[action];
+			stack.push_back({ 0, edge.next, item.state });
+			stack.push_back({ edge.symbol, -1, item.state });
+		}
+		else if (GRB::Rule::Chain::isN(item.symbol))
+		{
+			const short nrule = table.rule(item.symbol);
+			if (nrule < 0)
+				return false;
+
+			stack.pop_back();
+			stack.push_back({ 0, table.root(nrule), static_cast<int>(m_derivation.size()) });
+			m_derivation.push_back({ m_tape_position, nrule, -1 });
+		}
+		else if (item.symbol == lexeme)
+		{
+			stack.pop_back();
+			++m_tape_position;
+		}
+		else
+			return false;
+	}
+
+	//     (        ):
+	//     ,     
+	for (const PredictiveItem& item : stack)
+	{
+		if (item.node >= 0 && m_derivation[item.state].m_nrulechain < 0)
+		{
+			m_derivation[item.state].m_nrulechain = table.node(item.node).firstChain;
+			MFST_TRACE7(m_derivation[item.state])
+		}
+	}
+
+	return true;
+}
+
+void TTM::SyntaxAnalyzer::reset()
+{
+	m_tape_position = 0;
+	m_nrule = -1;
+	m_nrulechain = -1;
+	m_stack.clear();
+	m_stack.push(greibach.stbottomT);
+	m_stack.push(greibach.startN);
+	m_storestate = use_container<std::stack<MfstState>>();
+	m_derivation.clear();
+	std::fill(std::begin(diagnosis), std::end(diagnosis), MfstDiagnosis());
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <stack>
 #include "Greibach.h"
+#include "PredictiveTable.h"
 #include "LexTable.h"
 #include "Error.h"
 #include "Logger.h"
@@ -10,34 +11,41 @@
 #define MFST_DIAGN_MAXSIZE 2*ERROR_MAXSIZE_MESSAGE
 #define MFST_DIAGN_NUMBER 3
 
-#define MFST_TRACE_START m_trace << std::setw(4)<<std::left<<""<<": " \
-	<< std::setw(30) << std::left << ""  \
-	<< std::setw(30) << std::left << " " \
-	<< std::setw(20) << std::left << "" \
+//  ,     (-trace):         ;
+//       ,      
+#define MFST_TRACE_START if (m_trace) (m_trace->left("", 4) << ": ") \
+	.left("", 30) \
+	.left(" ", 30) \
+	.left("", 20) \
 	<< '\n';
 
-#define MFST_TRACE1 m_trace <<std::setw(4)<<std::left<<++FST_TRACE_n<<": " \
-	<< std::setw(30) << std::left << rule.getCRule(m_nrulechain)  \
-	<< std::setw(30) << std::left << getCTape(m_tape_position) \
-	<< std::setw(20) << std::left << getCSt() \
+#define MFST_TRACE1 if (m_trace) (m_trace->left(++FST_TRACE_n, 4) << ": ") \
+	.left(rule.getCRule(m_nrulechain), 30) \
+	.left(getCTape(m_tape_position), 30) \
+	.left(getCSt(), 20) \
 	<< '\n';
 
-#define MFST_TRACE2    m_trace <<std::setw(4)<<std::left<<FST_TRACE_n<<": " \
-	<< std::setw(30) << std::left << " "  \
-	<< std::setw(30) << std::left << getCTape(m_tape_position) \
-	<< std::setw(20) << std::left << getCSt() \
+#define MFST_TRACE2    if (m_trace) (m_trace->left(FST_TRACE_n, 4) << ": ") \
+	.left(" ", 30) \
+	.left(getCTape(m_tape_position), 30) \
+	.left(getCSt(), 20) \
 	<< '\n';
 
-#define MFST_TRACE3     m_trace<<std::setw(4)<<std::left<<++FST_TRACE_n<<": " \
-	<< std::setw(30) << std::left << " "  \
-	<< std::setw(30) << std::left << getCTape(m_tape_position) \
-	<< std::setw(20) << std::left << getCSt() \
+#define MFST_TRACE3     if (m_trace) (m_trace->left(++FST_TRACE_n, 4) << ": ") \
+	.left(" ", 30) \
+	.left(getCTape(m_tape_position), 30) \
+	.left(getCSt(), 20) \
 	<< '\n';
 
-#define MFST_TRACE4(c) m_trace<<std::setw(4)<<std::left<<++FST_TRACE_n<<": "<<std::setw(20)<<std::left<<c<<'\n';
-#define MFST_TRACE5(c) m_trace<<std::setw(4)<<std::left<<  FST_TRACE_n<<": "<<std::setw(20)<<std::left<<c<<'\n';
+#define MFST_TRACE4(c) if (m_trace) (m_trace->left(++FST_TRACE_n, 4) << ": ").left(c, 20) << '\n';
+#define MFST_TRACE5(c) if (m_trace) (m_trace->left(  FST_TRACE_n, 4) << ": ").left(c, 20) << '\n';
 
-#define MFST_TRACE6(c,k) m_trace<<std::setw(4)<<std::left<<++FST_TRACE_n<<": "<<std::setw(20)<<std::left<<c<<k<<'\n';
+#define MFST_TRACE6(c,k) if (m_trace) (m_trace->left(++FST_TRACE_n, 4) << ": ").left(c, 20) << k << '\n';
+
+#define MFST_TRACE7(state) if (m_trace) (m_trace->left(++FST_TRACE_n, 4) << ": ") \
+	.left(greibach.getRule((state).m_nrule).getCRule((state).m_nrulechain), 30) \
+	.left(getCTape((state).m_tape_position), 30) \
+	<< '\n';
 
 #pragma endregion
 
@@ -48,31 +56,80 @@ struct use_container : T
 	using T::c;
 };
 
-typedef use_container<std::stack<short>> MFSTSTACK;
-
 namespace TTM
 {
+	//   -      ,       .
+	//  -     ;   ,   , :
+	//       ,      
+	class MfstStack
+	{
+	public:
+		struct Snapshot
+		{
+			int top;
+			int poolSize;
+		};
+
+		void push(GRBALPHABET symbol)
+		{
+			m_pool.push_back({ symbol, m_top });
+			m_top = static_cast<int>(m_pool.size()) - 1;
+		}
+		void pop() { m_top = m_pool[m_top].next; }
+		GRBALPHABET top() const { return m_pool[m_top].symbol; }
+		bool empty() const { return m_top < 0; }
+
+		Snapshot save() const { return { m_top, static_cast<int>(m_pool.size()) }; }
+		void restore(Snapshot snapshot)
+		{
+			m_pool.resize(snapshot.poolSize);
+			m_top = snapshot.top;
+		}
+		void clear()
+		{
+			m_pool.clear();
+			m_top = -1;
+		}
+
+		//     
+		std::string str() const;
+
+	private:
+		struct Node
+		{
+			GRBALPHABET symbol;
+			int next;
+		};
+
+		std::pmr::vector<Node> m_pool;
+		int m_top = -1;
+	};
+
 	struct MfstState
 	{
-		short m_tape_position;
+		int m_tape_position;
 		short m_nrule;
 		short m_nrulechain;
-		MFSTSTACK m_stack;
+		MfstStack::Snapshot m_stack;
 
 		MfstState();
-		MfstState(short position, MFSTSTACK m_stack, short m_nrulechain);
-		MfstState(short position, MFSTSTACK m_stack, short m_nrule, short m_nrulechain);
+		MfstState(int position, MfstStack::Snapshot m_stack, short m_nrulechain);
+		MfstState(int position, MfstStack::Snapshot m_stack, short m_nrule, short m_nrulechain);
 	};
 
 	class SyntaxAnalyzer
 	{
 	public:
 		SyntaxAnalyzer();
-		SyntaxAnalyzer(const TTM::LexTable& lextable, const GRB::Greibach& greibach);
+		// trace -    (-trace)  nullptr;       
+		SyntaxAnalyzer(const TTM::LexTable& lextable, const GRB::Greibach& greibach, BufferedWriter* trace = nullptr);
 
 		bool Start(Logger& log);
-		std::string dumpTrace() const;
-		std::string getRules();
+		//     LL(1)      ;
+		//     ,    ,      Start(log)
+		bool Start(Logger& log, const GRB::PredictiveTable& table);
+		//       
+		void dumpRules(BufferedWriter& output, dump::format format = dump::format::text);
 
 	private:
 		enum class RC_STEP
@@ -89,32 +146,53 @@ namespace TTM
 
 		struct MfstDiagnosis
 		{
-			short m_tape_position;
+			int m_tape_position;
 			RC_STEP rc_step;
 			short m_nrule;
 			short nrule_chain;
 
 			MfstDiagnosis();
-			MfstDiagnosis(short m_tape_position, RC_STEP rc_step, short m_nrule, short nrule_chain);
+			MfstDiagnosis(int m_tape_position, RC_STEP rc_step, short m_nrule, short nrule_chain);
 		} diagnosis[MFST_DIAGN_NUMBER];
 
-		GRBALPHABET* m_tape;
-		short m_tape_position;
+		//    :       (node >= 0);
+		// state -   m_derivation  ,    
+		struct PredictiveItem
+		{
+			GRBALPHABET symbol;
+			short node;
+			int state;
+		};
+
+		// ,    :     m_storestate
+		struct Derivation
+		{
+			int m_tape_position;
+			short m_nrule;
+			short m_nrulechain;
+		};
+
+		//    - int:       32767
+		std::pmr::vector<GRBALPHABET> m_tape;
+		int m_tape_position;
 		short m_nrule;
 		short m_nrulechain;
-		short m_tape_size;
+		int m_tape_size;
 		GRB::Greibach greibach;
+		GRB::ChainIndex m_chains;
 		const TTM::LexTable& lextable;
-		MFSTSTACK m_stack;
+		MfstStack m_stack;
 		use_container<std::stack<MfstState>> m_storestate;
-		std::stringstream m_trace;
-		std::stringstream m_rules;
+		std::pmr::vector<Derivation> m_derivation;
+		BufferedWriter* m_trace;
 
 		std::string getCSt();
-		std::string getCTape(short pos, short n = 25);
+		std::string getCTape(int pos, int n = 25);
+		bool predict(const GRB::PredictiveTable& table);
+		void reset();
 		bool save_state();
 		bool restore_state();
-		bool push_chain(GRB::Rule::Chain chain);
+		bool push_chain(const GRB::Rule::Chain& chain);
 		RC_STEP step();
 		bool savediagnosis(RC_STEP rc_step);
 	};
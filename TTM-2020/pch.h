@@ -13,6 +13,7 @@
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <vector>
 #include <stack>
@@ -21,5 +22,14 @@
 #include <map>
 #include <unordered_map>
 #include <list>
+#include <deque>
 #include <set>
-#include <unordered_set>
\ No newline at end of file
+#include <unordered_set>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <charconv>
+#include <bitset>
\ No newline at end of file